@@ -0,0 +1,146 @@
+{SHADER_VERSION}
+{SHADER_TYPE}
+
+#ifdef TYPE_VERTEX
+
+layout(location = 0) in vec3 vertexPosition;
+layout(location = 1) in vec3 vertexNormal;   // Unused
+layout(location = 2) in vec2 vertexUV;
+
+smooth out vec2 fragmentUV;
+
+void main() {
+    gl_Position = vec4(vertexPosition, 1.0f);
+    fragmentUV = vertexUV;
+}
+
+#endif
+
+#ifdef TYPE_FRAGMENT
+
+#define TYPE_POINT    0
+#define TYPE_SPOT     1
+#define TYPE_DIRECTED 2
+
+#define LIGHTS_MAX    256
+
+struct Light {
+    vec3 position;
+    float range;
+    vec3 direction;
+    int type;
+    vec3 color;
+    float energy;
+    float falloff;
+    float angle;
+    float blend;
+};
+
+layout(std140) uniform Lights {
+    Light lights[LIGHTS_MAX];
+};
+
+uniform vec3 cameraPosition;
+uniform mat4 modelView;
+uniform mat4 inverseViewProjection;
+
+uniform int clustersWidth;
+uniform int clustersHeight;
+uniform int clustersDepth;
+uniform float depthScale;
+uniform float depthBias;
+
+uniform sampler2D diffuseSampler;
+uniform sampler2D specularSampler;
+uniform sampler2D normalSampler;
+uniform sampler2D depthSampler;
+
+uniform usamplerBuffer clustersSampler;  // Offset and count of the cluster's lights
+uniform usamplerBuffer lightsSampler;    // Light indices
+
+smooth in vec2 fragmentUV;
+
+layout(location = 0) out vec4 outputColor;
+
+#define SPECULAR_HARDNESS_SCALE 65535.0f  // Unsigned normalized storage, see Window::update()
+
+// See http://jcgt.org/published/0003/02/01/ (octahedral normal vectors)
+vec3 decodeNormal(vec2 encoded) {
+    encoded = encoded * 2.0f - 1.0f;
+    vec3 normal = vec3(encoded, 1.0f - abs(encoded.x) - abs(encoded.y));
+
+    float fold = max(-normal.z, 0.0f);
+    normal.x += (normal.x >= 0.0f) ? -fold : fold;
+    normal.y += (normal.y >= 0.0f) ? -fold : fold;
+
+    return normalize(normal);
+}
+
+vec3 reconstructPosition(vec2 uv) {
+    vec4 ndcPosition = vec4(vec3(uv, texture(depthSampler, uv).r) * 2.0f - 1.0f, 1.0f);
+    vec4 worldPosition = inverseViewProjection * ndcPosition;
+    return worldPosition.xyz / worldPosition.w;
+}
+
+void main() {
+    vec4 diffuseSample = texture(diffuseSampler, fragmentUV);
+    vec4 specularSample = texture(specularSampler, fragmentUV);
+    vec4 normalSample = texture(normalSampler, fragmentUV);
+
+    vec3 position = reconstructPosition(fragmentUV);
+    vec3 normal = decodeNormal(normalSample.xy);
+
+    float depth = (modelView * vec4(position, 1.0f)).z;
+    if (depth <= 0.0f) {
+        discard;
+    }
+
+    // Same froxel layout as LightGrid: uniform tiles, exponential depth slices
+    ivec3 cluster = ivec3(fragmentUV * vec2(clustersWidth, clustersHeight), log(depth) * depthScale + depthBias);
+    cluster = clamp(cluster, ivec3(0), ivec3(clustersWidth, clustersHeight, clustersDepth) - 1);
+
+    int clusterIndex = (cluster.z * clustersHeight + cluster.y) * clustersWidth + cluster.x;
+    uvec2 clusterLights = texelFetch(clustersSampler, clusterIndex).xy;
+
+    vec3 cameraDirection = normalize(position - cameraPosition);
+    float diffuseIntensity = normalSample.z;
+    float specularHardness = normalSample.w * SPECULAR_HARDNESS_SCALE;
+    float specularIntensity = specularSample.a;
+
+    vec3 color = vec3(0.0f);
+
+    for (uint i = 0u; i < clusterLights.y; i++) {
+        Light light = lights[texelFetch(lightsSampler, int(clusterLights.x + i)).x];
+
+        vec3 direction = (light.type == TYPE_POINT) ? position - light.position : light.direction;
+        direction = normalize(direction);
+
+        float luminance = dot(-direction, normal);
+        vec3 diffuseColor = diffuseSample.rgb * light.color * (luminance > 0.0f ? luminance : 0.0f) * diffuseIntensity;
+
+        vec3 reflectedDirection = reflect(direction, normal);
+        float highlight = pow(dot(-cameraDirection, reflectedDirection), specularHardness);
+        vec3 specularColor = specularSample.rgb * (highlight > 0.0f ? highlight : 0.0f) * specularIntensity;
+
+        float lightAttenuation = 1.0f;
+        if (light.type != TYPE_DIRECTED) {
+            float falloff = pow(light.falloff, 2);
+            float distance = pow(distance(light.position, position), 2);
+            lightAttenuation = falloff / (falloff + distance);
+        }
+
+        float borderAttenuation = 1.0f;
+        if (light.type == TYPE_SPOT) {
+            float softBorder = cos(radians(light.angle) / 2.0);
+            float hardBorder = cos(radians(light.angle * (1.0 - light.blend)) / 2.0);
+            float lightAngle = dot(direction, normalize(position - light.position));
+            borderAttenuation = clamp((lightAngle - softBorder) / (hardBorder - softBorder), 0.0f, 1.0f);
+        }
+
+        color += (diffuseColor + specularColor) * light.energy * lightAttenuation * borderAttenuation;
+    }
+
+    outputColor = vec4(color, 0.0f);
+}
+
+#endif
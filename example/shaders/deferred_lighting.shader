@@ -22,6 +22,13 @@ void main() {
 #define TYPE_SPOT     1
 #define TYPE_DIRECTED 2
 
+// Specialized permutations fold the light type branches at compile time
+#ifdef LIGHT_TYPE
+#define lightType LIGHT_TYPE
+#else
+#define lightType light.type
+#endif
+
 layout(std140) uniform Light {
     vec3 color;
     int type;
@@ -32,12 +39,12 @@ layout(std140) uniform Light {
 } light;
 
 uniform vec3 cameraPosition;
+uniform mat4 inverseViewProjection;
 uniform vec3 lightPosition;
 uniform vec3 lightDirection;
 
 uniform sampler2D diffuseSampler;
 uniform sampler2D specularSampler;
-uniform sampler2D positionSampler;
 uniform sampler2D normalSampler;
 uniform sampler2D depthSampler;
 
@@ -45,39 +52,58 @@ smooth in vec2 fragmentUV;
 
 layout(location = 0) out vec4 outputColor;
 
+#define SPECULAR_HARDNESS_SCALE 65535.0f  // Unsigned normalized storage, see Window::update()
+
+// See http://jcgt.org/published/0003/02/01/ (octahedral normal vectors)
+vec3 decodeNormal(vec2 encoded) {
+    encoded = encoded * 2.0f - 1.0f;
+    vec3 normal = vec3(encoded, 1.0f - abs(encoded.x) - abs(encoded.y));
+
+    float fold = max(-normal.z, 0.0f);
+    normal.x += (normal.x >= 0.0f) ? -fold : fold;
+    normal.y += (normal.y >= 0.0f) ? -fold : fold;
+
+    return normalize(normal);
+}
+
+vec3 reconstructPosition(vec2 uv) {
+    vec4 ndcPosition = vec4(vec3(uv, texture(depthSampler, uv).r) * 2.0f - 1.0f, 1.0f);
+    vec4 worldPosition = inverseViewProjection * ndcPosition;
+    return worldPosition.xyz / worldPosition.w;
+}
+
 void main() {
     vec4 diffuseSample = texture(diffuseSampler, fragmentUV);
     vec4 specularSample = texture(specularSampler, fragmentUV);
-    vec4 positionSample = texture(positionSampler, fragmentUV);
     vec4 normalSample = texture(normalSampler, fragmentUV);
 
-    vec3 position = positionSample.xyz;
-    vec3 normal = normalize(normalSample.xyz);
+    vec3 position = reconstructPosition(fragmentUV);
+    vec3 normal = decodeNormal(normalSample.xy);
 
-    vec3 direction = (light.type == TYPE_POINT) ? position - lightPosition : lightDirection;
+    vec3 direction = (lightType == TYPE_POINT) ? position - lightPosition : lightDirection;
     direction = normalize(direction);
 
     float luminance = dot(-direction, normal);
-    float diffuseIntensity = specularSample.a;
+    float diffuseIntensity = normalSample.z;
     vec3 diffuseColor = diffuseSample.rgb * light.color * (luminance > 0.0f ? luminance : 0.0f) * diffuseIntensity;
 
     vec3 cameraDirection = normalize(position - cameraPosition);
     vec3 reflectedDirection = reflect(direction, normal);
 
-    float specularHardness = normalSample.a;
-    float specularIntensity = positionSample.a;
+    float specularHardness = normalSample.w * SPECULAR_HARDNESS_SCALE;
+    float specularIntensity = specularSample.a;
     float highlight = pow(dot(-cameraDirection, reflectedDirection), specularHardness);
     vec3 specularColor = specularSample.rgb * (highlight > 0.0f ? highlight : 0.0f) * specularIntensity;
 
     float lightAttenuation = 1.0f;
-    if (light.type != TYPE_DIRECTED) {
+    if (lightType != TYPE_DIRECTED) {
         float falloff = pow(light.falloff, 2);
         float distance = pow(distance(lightPosition, position), 2);
         lightAttenuation = falloff / (falloff + distance);
     }
 
     float borderAttenuation = 1.0f;
-    if (light.type == TYPE_SPOT) {
+    if (lightType == TYPE_SPOT) {
         float softBorder = cos(radians(light.angle) / 2.0);
         float hardBorder = cos(radians(light.angle * (1.0 - light.blend)) / 2.0);
         float lightAngle = dot(direction, normalize(position - lightPosition));
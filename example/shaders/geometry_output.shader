@@ -6,29 +6,40 @@
 layout(location = 0) in vec3 vertexPosition;
 layout(location = 1) in vec3 vertexNormal;
 layout(location = 2) in vec2 vertexUV;
+layout(location = 3) in mat4 localWorld;  // Per instance, locations 3-6
+layout(location = 7) in mat4 normalRotation;  // Per instance, locations 7-10
 
 uniform mat4 modelViewProjection;
-uniform mat4 normalRotation;
-uniform mat4 localWorld;
 
-smooth out vec3 fragmentPosition;
+// Depth pre-pass and G-buffer programs meet at GL_EQUAL, see RenderGeometry::update()
+invariant gl_Position;
+
 smooth out vec3 fragmentNormal;
 smooth out vec2 fragmentUV;
 
 void main() {
     vec4 vertexWorldPosition = localWorld * vec4(vertexPosition, 1.0f);
-    vec4 vertexWorldNormal = normalRotation * vec4(vertexNormal, 1.0f);
     gl_Position = modelViewProjection * vertexWorldPosition;
 
-    fragmentPosition = vec3(vertexWorldPosition);
+#ifndef DEPTH_ONLY
+    vec4 vertexWorldNormal = normalRotation * vec4(vertexNormal, 1.0f);
     fragmentNormal = vec3(vertexWorldNormal);
     fragmentUV = vertexUV;
+#endif
 }
 
 #endif
 
 #ifdef TYPE_FRAGMENT
 
+#ifdef DEPTH_ONLY
+
+void main() {
+    // Color writes are masked, depth only
+}
+
+#else
+
 layout(std140) uniform Material {
     float ambientIntensity;
     float diffuseIntensity;
@@ -41,22 +52,44 @@ layout(std140) uniform Material {
 
 uniform sampler2D diffuseSampler;
 
-smooth in vec3 fragmentPosition;
+// Specialized permutations fold the texture branch at compile time
+#ifdef HAS_DIFFUSE_TEXTURE
+#define hasDiffuseTexture HAS_DIFFUSE_TEXTURE
+#else
+#define hasDiffuseTexture material.hasDiffuseTexture
+#endif
+
 smooth in vec3 fragmentNormal;
 smooth in vec2 fragmentUV;
 
 layout(location = 0) out vec4 outputDiffuse;
 layout(location = 1) out vec4 outputSpecular;
-layout(location = 2) out vec4 outputPosition;
-layout(location = 3) out vec4 outputNormal;
+layout(location = 2) out vec4 outputNormal;
+
+#define SPECULAR_HARDNESS_SCALE 65535.0f  // Unsigned normalized storage, see Window::update()
+
+// See http://jcgt.org/published/0003/02/01/ (octahedral normal vectors)
+vec2 encodeNormal(vec3 normal) {
+    normal /= abs(normal.x) + abs(normal.y) + abs(normal.z);
+    vec2 encoded = normal.xy;
+
+    if (normal.z < 0.0f) {
+        vec2 signs = vec2(normal.x >= 0.0f ? 1.0f : -1.0f, normal.y >= 0.0f ? 1.0f : -1.0f);
+        encoded = (1.0f - abs(normal.yx)) * signs;
+    }
+
+    return encoded * 0.5f + 0.5f;
+}
 
 void main() {
-    vec3 diffuseColor = material.hasDiffuseTexture ? texture(diffuseSampler, fragmentUV).rgb : material.diffuseColor;
+    vec3 diffuseColor = hasDiffuseTexture ? texture(diffuseSampler, fragmentUV).rgb : material.diffuseColor;
 
     outputDiffuse = vec4(diffuseColor, material.ambientIntensity);
-    outputSpecular = vec4(material.specularColor, material.diffuseIntensity);
-    outputPosition = vec4(fragmentPosition, material.specularIntensity);
-    outputNormal = vec4(fragmentNormal, material.specularHardness);
+    outputSpecular = vec4(material.specularColor, material.specularIntensity);
+    outputNormal = vec4(encodeNormal(normalize(fragmentNormal)), material.diffuseIntensity,
+            material.specularHardness / SPECULAR_HARDNESS_SCALE);
 }
 
+#endif  // DEPTH_ONLY
+
 #endif
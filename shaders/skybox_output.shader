@@ -43,16 +43,14 @@ smooth in vec3 fragmentUV;
 
 layout(location = 0) out vec4 outputDiffuse;
 layout(location = 1) out vec4 outputSpecular;
-layout(location = 2) out vec4 outputPosition;
-layout(location = 3) out vec4 outputNormal;
+layout(location = 2) out vec4 outputNormal;
 
 void main() {
     vec3 diffuseColor = material.hasDiffuseTexture ? texture(diffuseSampler, fragmentUV).rgb : material.diffuseColor;
 
     outputDiffuse = vec4(diffuseColor, 1.0f);
     outputSpecular = vec4(0.0f, 0.0f, 0.0f, 0.0f);
-    outputPosition = vec4(0.0f, 0.0f, 0.0f, 0.0f);
-    outputNormal = vec4(0.0f, 0.0f, 0.0f, 0.0f);
+    outputNormal = vec4(0.5f, 0.5f, 0.0f, 0.0f);  // Facing +Z, unlit
 }
 
 #endif
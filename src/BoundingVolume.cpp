@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <BoundingVolume.h>
+#include <Logger.h>
+#include <Vec4.h>
+#include <algorithm>
+#include <stdexcept>
+#include <cmath>
+
+namespace Graphene {
+
+BoundingBox::BoundingBox(const Math::Vec3& minimum, const Math::Vec3& maximum):
+        minimum(minimum),
+        maximum(maximum),
+        empty(false) {
+    for (int axis = Math::Vec3::X; axis <= Math::Vec3::Z; axis++) {
+        if (minimum.get(axis) > maximum.get(axis)) {
+            throw std::invalid_argument(LogFormat("Minimum is greater than maximum"));
+        }
+    }
+}
+
+const Math::Vec3& BoundingBox::getMinimum() const {
+    return this->minimum;
+}
+
+const Math::Vec3& BoundingBox::getMaximum() const {
+    return this->maximum;
+}
+
+Math::Vec3 BoundingBox::getCenter() const {
+    return (this->minimum + this->maximum) / 2.0f;
+}
+
+Math::Vec3 BoundingBox::getExtents() const {
+    return (this->maximum - this->minimum) / 2.0f;
+}
+
+bool BoundingBox::isEmpty() const {
+    return this->empty;
+}
+
+void BoundingBox::merge(const Math::Vec3& point) {
+    if (this->empty) {
+        this->minimum = point;
+        this->maximum = point;
+        this->empty = false;
+        return;
+    }
+
+    for (int axis = Math::Vec3::X; axis <= Math::Vec3::Z; axis++) {
+        this->minimum.set(axis, std::min(this->minimum.get(axis), point.get(axis)));
+        this->maximum.set(axis, std::max(this->maximum.get(axis), point.get(axis)));
+    }
+}
+
+void BoundingBox::merge(const BoundingBox& box) {
+    if (box.empty) {
+        return;
+    }
+
+    this->merge(box.minimum);
+    this->merge(box.maximum);
+}
+
+BoundingBox BoundingBox::transform(const Math::Mat4& transformation) const {
+    if (this->empty) {
+        return BoundingBox();
+    }
+
+    // Transform the center and project the extents on the new axes, see
+    // J. Arvo, "Transforming Axis-Aligned Bounding Boxes", Graphics Gems, 1990
+    Math::Vec3 center(Math::Vec4(transformation * Math::Vec4(this->getCenter(), 1.0f)).extractVec3());
+    Math::Vec3 extents(this->getExtents());
+    Math::Vec3 newExtents;
+
+    for (int row = 0; row < 3; row++) {
+        float extent = 0.0f;
+        for (int column = 0; column < 3; column++) {
+            extent += fabsf(transformation.get(row, column)) * extents.get(column);
+        }
+
+        newExtents.set(row, extent);
+    }
+
+    return BoundingBox(center - newExtents, center + newExtents);
+}
+
+bool BoundingBox::intersects(const Math::Vec3& origin, const Math::Vec3& direction, float distance) const {
+    if (this->empty) {
+        return false;
+    }
+
+    // Slab test, the ray is clipped to the box one axis at a time
+    float entryDistance = 0.0f;
+    float exitDistance = distance;
+
+    for (int axis = Math::Vec3::X; axis <= Math::Vec3::Z; axis++) {
+        float inverseDirection = 1.0f / direction.get(axis);
+        float first = (this->minimum.get(axis) - origin.get(axis)) * inverseDirection;
+        float second = (this->maximum.get(axis) - origin.get(axis)) * inverseDirection;
+
+        entryDistance = std::max(entryDistance, std::min(first, second));
+        exitDistance = std::min(exitDistance, std::max(first, second));
+    }
+
+    return entryDistance <= exitDistance;
+}
+
+BoundingSphere::BoundingSphere(const Math::Vec3& center, float radius):
+        center(center),
+        radius(radius) {
+    if (radius < 0.0f) {
+        throw std::invalid_argument(LogFormat("Radius is less than 0.0f"));
+    }
+}
+
+const Math::Vec3& BoundingSphere::getCenter() const {
+    return this->center;
+}
+
+float BoundingSphere::getRadius() const {
+    return this->radius;
+}
+
+bool BoundingSphere::isEmpty() const {
+    return this->radius < 0.0f;
+}
+
+void BoundingSphere::merge(const BoundingSphere& sphere) {
+    if (sphere.isEmpty()) {
+        return;
+    }
+
+    if (this->isEmpty()) {
+        *this = sphere;
+        return;
+    }
+
+    Math::Vec3 offset(sphere.center - this->center);
+    float distance = sqrtf(offset.dot(offset));
+
+    if (distance + sphere.radius <= this->radius) {
+        return;  // Other sphere is inside
+    }
+
+    if (distance + this->radius <= sphere.radius) {
+        *this = sphere;
+        return;
+    }
+
+    float newRadius = (distance + this->radius + sphere.radius) / 2.0f;
+    this->center = this->center + offset * ((newRadius - this->radius) / distance);
+    this->radius = newRadius;
+}
+
+BoundingSphere BoundingSphere::transform(const Math::Mat4& transformation) const {
+    if (this->isEmpty()) {
+        return BoundingSphere();
+    }
+
+    // Non-uniform scaling stretches the sphere, the largest axis bounds it
+    float maxScale = 0.0f;
+    for (int column = 0; column < 3; column++) {
+        Math::Vec3 axis(transformation.get(0, column), transformation.get(1, column), transformation.get(2, column));
+        maxScale = std::max(maxScale, axis.dot(axis));
+    }
+
+    Math::Vec3 center(Math::Vec4(transformation * Math::Vec4(this->center, 1.0f)).extractVec3());
+    return BoundingSphere(center, this->radius * sqrtf(maxScale));
+}
+
+}  // namespace Graphene
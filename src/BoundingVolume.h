@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BOUNDINGVOLUME_H
+#define BOUNDINGVOLUME_H
+
+#include <GrapheneApi.h>
+#include <Mat4.h>
+#include <Vec3.h>
+
+namespace Graphene {
+
+class BoundingBox {
+public:
+    GRAPHENE_API BoundingBox() = default;  // Empty box, merging anything gives that thing back
+    GRAPHENE_API BoundingBox(const Math::Vec3& minimum, const Math::Vec3& maximum);
+
+    GRAPHENE_API const Math::Vec3& getMinimum() const;
+    GRAPHENE_API const Math::Vec3& getMaximum() const;
+    GRAPHENE_API Math::Vec3 getCenter() const;
+    GRAPHENE_API Math::Vec3 getExtents() const;
+    GRAPHENE_API bool isEmpty() const;
+
+    GRAPHENE_API void merge(const Math::Vec3& point);
+    GRAPHENE_API void merge(const BoundingBox& box);
+    GRAPHENE_API BoundingBox transform(const Math::Mat4& transformation) const;
+
+    GRAPHENE_API bool intersects(const Math::Vec3& origin, const Math::Vec3& direction, float distance) const;  // Ray up to distance
+
+private:
+    Math::Vec3 minimum;
+    Math::Vec3 maximum;
+    bool empty = true;
+};
+
+class BoundingSphere {
+public:
+    GRAPHENE_API BoundingSphere() = default;  // Empty sphere, merging anything gives that thing back
+    GRAPHENE_API BoundingSphere(const Math::Vec3& center, float radius);
+
+    GRAPHENE_API const Math::Vec3& getCenter() const;
+    GRAPHENE_API float getRadius() const;
+    GRAPHENE_API bool isEmpty() const;
+
+    GRAPHENE_API void merge(const BoundingSphere& sphere);
+    GRAPHENE_API BoundingSphere transform(const Math::Mat4& transformation) const;
+
+private:
+    Math::Vec3 center;
+    float radius = -1.0f;
+};
+
+}  // namespace Graphene
+
+#endif  // BOUNDINGVOLUME_H
@@ -33,4 +33,8 @@ const std::shared_ptr<Entity> Component::getParent() const {
     return this->parent.lock();
 }
 
+BoundingBox Component::getBoundingBox() const {
+    return BoundingBox();
+}
+
 }  // namespace Graphene
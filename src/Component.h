@@ -27,6 +27,7 @@
 #include <NonCopyable.h>
 #include <MetaObject.h>
 #include <ComponentEvent.h>
+#include <BoundingVolume.h>
 
 namespace Graphene {
 
@@ -41,6 +42,8 @@ public:
     GRAPHENE_API virtual void receiveEvent(const std::shared_ptr<ComponentEvent>& event) = 0;
     GRAPHENE_API virtual void update(float deltaTime) = 0;
 
+    GRAPHENE_API virtual BoundingBox getBoundingBox() const;  // Empty unless the component has geometry
+
 protected:
     Component(MetaType objectType);
 
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <ContextWorker.h>
+#include <Logger.h>
+#include <stdexcept>
+#include <exception>
+
+namespace Graphene {
+
+ContextWorker::ContextWorker(const std::function<void()>& makeCurrent, const std::function<void()>& releaseCurrent):
+        makeCurrent(makeCurrent),
+        releaseCurrent(releaseCurrent),
+        worker(&ContextWorker::runWorker, this) {
+}
+
+ContextWorker::~ContextWorker() {
+    {
+        std::lock_guard<std::mutex> lock(this->tasksMutex);
+        this->stopping = true;
+    }
+
+    this->tasksPending.notify_one();
+    this->worker.join();
+}
+
+std::future<void> ContextWorker::post(const std::function<void()>& task) {
+    std::future<void> done;
+
+    {
+        std::lock_guard<std::mutex> lock(this->tasksMutex);
+        this->tasks.push_back({ task, std::promise<void>() });
+        done = this->tasks.back().done.get_future();
+    }
+
+    this->tasksPending.notify_one();
+    return done;
+}
+
+void ContextWorker::runWorker() {
+    std::exception_ptr contextError;
+
+    try {
+        this->makeCurrent();
+    } catch (const std::exception& e) {
+        LogError("Context worker is unable to make its context current: %s", e.what());
+        contextError = std::current_exception();
+    }
+
+    while (true) {
+        Task task;
+
+        {
+            std::unique_lock<std::mutex> lock(this->tasksMutex);
+            this->tasksPending.wait(lock, [this]() {
+                return this->stopping || !this->tasks.empty();
+            });
+
+            if (this->tasks.empty()) {
+                break;  // Stopping and drained
+            }
+
+            task = std::move(this->tasks.front());
+            this->tasks.pop_front();
+        }
+
+        if (contextError != nullptr) {
+            task.done.set_exception(contextError);
+            continue;
+        }
+
+        try {
+            task.task();
+            task.done.set_value();
+        } catch (...) {
+            task.done.set_exception(std::current_exception());
+        }
+    }
+
+    if (contextError == nullptr) {
+        this->releaseCurrent();
+    }
+}
+
+}  // namespace Graphene
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CONTEXTWORKER_H
+#define CONTEXTWORKER_H
+
+#include <GrapheneApi.h>
+#include <NonCopyable.h>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <deque>
+
+namespace Graphene {
+
+/*
+ * Single thread owning a context shared with the rendering one, tasks run in the posting
+ * order. Objects created by a task are visible to the rendering context only after a fence
+ * the task placed is signaled, the returned future merely tells the commands were issued.
+ * Pending tasks still run on destruction, so the context is released last.
+ */
+class ContextWorker: public NonCopyable {
+public:
+    // Both are called on the worker thread, makeCurrent() throws if the context is unusable
+    GRAPHENE_API ContextWorker(const std::function<void()>& makeCurrent, const std::function<void()>& releaseCurrent);
+    GRAPHENE_API ~ContextWorker();
+
+    GRAPHENE_API std::future<void> post(const std::function<void()>& task);
+
+private:
+    typedef struct {
+        std::function<void()> task;
+        std::promise<void> done;
+    } Task;
+
+    void runWorker();
+
+    std::function<void()> makeCurrent;
+    std::function<void()> releaseCurrent;
+
+    std::deque<Task> tasks;
+    std::mutex tasksMutex;
+    std::condition_variable tasksPending;
+    bool stopping = false;
+
+    std::thread worker;  // Started last, everything above is set up by then
+};
+
+}  // namespace Graphene
+
+#endif  // CONTEXTWORKER_H
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <DynamicBuffer.h>
+#include <GLStateCache.h>
+#include <Logger.h>
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+
+#define FENCE_TIMEOUT 1000000  // 1ms in nanoseconds
+
+namespace Graphene {
+
+DynamicBuffer::DynamicBuffer(GLenum target, size_t frameSize, int frames):
+        target(target),
+        frameSize(frameSize) {
+    if (frameSize == 0) {
+        throw std::invalid_argument(LogFormat("Frame size cannot be 0"));
+    }
+
+    if (frames < 1) {
+        throw std::invalid_argument(LogFormat("Frames count is less than 1"));
+    }
+
+    this->fences.resize(frames, nullptr);
+    this->createBuffer();
+}
+
+DynamicBuffer::~DynamicBuffer() {
+    this->deleteBuffer();
+}
+
+GLuint DynamicBuffer::getHandle() const {
+    return this->buffer;
+}
+
+uint64_t DynamicBuffer::getGeneration() const {
+    return this->generation;
+}
+
+size_t DynamicBuffer::getFrameSize() const {
+    return this->frameSize;
+}
+
+size_t DynamicBuffer::write(const void* data, size_t dataSize, size_t alignment) {
+    size_t alignedOffset = (this->frameOffset + alignment - 1) / alignment * alignment;
+
+    if (alignedOffset + dataSize > this->frameSize) {
+        // Draws issued earlier keep the old buffer alive until they are done
+        LogWarn("Dynamic buffer frame size %zu exceeded, growing", this->frameSize);
+
+        this->deleteBuffer();
+        this->frameSize = std::max(this->frameSize * 2, dataSize);
+        this->createBuffer();
+
+        alignedOffset = 0;
+    }
+
+    size_t bufferOffset = this->frameSize * this->frameIndex + alignedOffset;
+
+    if (this->mappedBuffer != nullptr) {
+        std::memcpy(this->mappedBuffer + bufferOffset, data, dataSize);
+    } else {
+        // Region is guarded by the frame fence, the driver need not synchronize
+        GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+
+        GetGLStateCache().bindBuffer(this->target, this->buffer);
+        void* mappedRange = glMapBufferRange(this->target, bufferOffset, dataSize, access);
+        if (mappedRange == nullptr) {
+            throw std::runtime_error(LogFormat("Failed to map dynamic buffer range of %zu bytes", dataSize));
+        }
+
+        std::memcpy(mappedRange, data, dataSize);
+        glUnmapBuffer(this->target);
+    }
+
+    this->frameOffset = alignedOffset + dataSize;
+
+    return bufferOffset;
+}
+
+void DynamicBuffer::beginFrame() {
+    this->frameIndex = (this->frameIndex + 1) % this->fences.size();
+    this->frameOffset = 0;
+
+    GLsync& fence = this->fences[this->frameIndex];
+    if (fence == nullptr) {
+        return;
+    }
+
+    GLenum waitStatus = GL_TIMEOUT_EXPIRED;
+    while (waitStatus == GL_TIMEOUT_EXPIRED) {
+        waitStatus = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT);
+    }
+
+    if (waitStatus == GL_WAIT_FAILED) {
+        LogWarn("Dynamic buffer frame %d fence wait failed", this->frameIndex);
+    }
+
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+void DynamicBuffer::endFrame() {
+    GLsync& fence = this->fences[this->frameIndex];
+    if (fence != nullptr) {
+        glDeleteSync(fence);
+    }
+
+    fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void DynamicBuffer::createBuffer() {
+    static uint64_t nextGeneration = 1;
+    size_t bufferSize = this->frameSize * this->fences.size();
+
+    // Drivers hand a just deleted name out again, users key their cached state on the generation
+    glGenBuffers(1, &this->buffer);
+    this->generation = nextGeneration++;
+    GetGLStateCache().bindBuffer(this->target, this->buffer);
+
+    if (OpenGL::isExtensionSupported("GL_ARB_buffer_storage")) {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+        glBufferStorage(this->target, bufferSize, nullptr, flags);
+        this->mappedBuffer = reinterpret_cast<char*>(glMapBufferRange(this->target, 0, bufferSize, flags));
+
+        if (this->mappedBuffer == nullptr) {
+            LogWarn("Dynamic buffer persistent mapping failed, mapping every write");
+        }
+    } else {
+        glBufferData(this->target, bufferSize, nullptr, GL_STREAM_DRAW);
+    }
+}
+
+void DynamicBuffer::deleteBuffer() {
+    if (this->mappedBuffer != nullptr) {
+        GetGLStateCache().bindBuffer(this->target, this->buffer);
+        glUnmapBuffer(this->target);
+        this->mappedBuffer = nullptr;
+    }
+
+    GetGLStateCache().deleteBuffer(this->buffer);
+    this->buffer = 0;
+
+    // Fresh storage has no pending readers
+    for (auto& fence: this->fences) {
+        if (fence != nullptr) {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+}
+
+}  // namespace Graphene
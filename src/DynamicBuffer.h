@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DYNAMICBUFFER_H
+#define DYNAMICBUFFER_H
+
+#include <GrapheneApi.h>
+#include <NonCopyable.h>
+#include <OpenGL.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Graphene {
+
+/*
+ * Ring of per-frame regions for data rewritten every frame. Writes go linearly into the region
+ * of the current frame, a region is reused only after the fence of the frame it was last written
+ * in has signaled. Storage is mapped persistently with GL_ARB_buffer_storage, otherwise every
+ * write maps its range unsynchronized.
+ */
+class DynamicBuffer: public NonCopyable {
+public:
+    GRAPHENE_API DynamicBuffer(GLenum target, size_t frameSize, int frames = 3);
+    GRAPHENE_API ~DynamicBuffer();
+
+    GRAPHENE_API GLuint getHandle() const;  // Changes if the buffer grows
+    GRAPHENE_API uint64_t getGeneration() const;  // Unique per storage, the handle alone may be reused
+    GRAPHENE_API size_t getFrameSize() const;
+
+    GRAPHENE_API size_t write(const void* data, size_t dataSize, size_t alignment);  // Returns the buffer offset
+
+    GRAPHENE_API void beginFrame();
+    GRAPHENE_API void endFrame();
+
+private:
+    void createBuffer();
+    void deleteBuffer();
+
+    GLenum target;
+    GLuint buffer = 0;
+    uint64_t generation = 0;
+    char* mappedBuffer = nullptr;  // Persistent mapping
+
+    size_t frameSize;
+    size_t frameOffset = 0;
+    int frameIndex = 0;
+
+    std::vector<GLsync> fences;  // One per frame region
+};
+
+}  // namespace Graphene
+
+#endif  // DYNAMICBUFFER_H
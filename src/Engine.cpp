@@ -26,6 +26,11 @@
 #include <RenderManager.h>
 #include <EngineConfig.h>
 #include <TextComponent.h>
+#include <TransformStore.h>
+#include <MaterialTable.h>
+#include <GLStateCache.h>
+#include <RenderTargetPool.h>
+#include <Shader.h>
 #if defined(_WIN32)
 #include <Win32Window.h>
 #elif defined(__linux__)
@@ -167,6 +172,11 @@ void Engine::setupWindow() {
     this->window->setVsync(config.isVsync());
     this->window->setFullscreen(config.isFullscreen());
 
+    if (config.isDynamicResolution()) {
+        this->window->setDynamicResolution(config.getTargetFps(), config.getMinResolutionScale(),
+                config.getMaxResolutionScale());
+    }
+
     this->window->onMouseMotionSignal.connect(
             Signals::Slot<int, int>(&Engine::onMouseMotion, this, std::placeholders::_1, std::placeholders::_2));
     this->window->onMouseButtonSignal.connect(
@@ -179,6 +189,9 @@ void Engine::setupOpenGL() {
     OpenGL::loadCore();
     OpenGL::loadExtensions();
 
+    auto& stateCache = GetGLStateCache();
+    stateCache.invalidate();  // Fresh context
+
     LogInfo("OpenGL vendor: %s", glGetString(GL_VENDOR));
     LogInfo("OpenGL renderer: %s", glGetString(GL_RENDERER));
     LogInfo("OpenGL version: %s", glGetString(GL_VERSION));
@@ -199,7 +212,7 @@ void Engine::setupOpenGL() {
 
     if (GetEngineConfig().isDebug()) {
         if (OpenGL::isExtensionSupported("GL_ARB_debug_output")) {
-            glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS_ARB);
+            stateCache.enable(GL_DEBUG_OUTPUT_SYNCHRONOUS_ARB);
             glDebugMessageControlARB(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, nullptr, true);
             glDebugMessageCallbackARB(debugHandler, nullptr);
         } else {
@@ -207,21 +220,32 @@ void Engine::setupOpenGL() {
         }
     }
 
+    if (OpenGL::isExtensionSupported("GL_KHR_parallel_shader_compile")) {
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);  // Implementation specific maximum
+    } else {
+        LogWarn("GL_KHR_parallel_shader_compile unavailable, shaders are built on a shared context thread");
+        Shader::setContextWorker(this->window->getContextWorker());
+    }
+
+    if (!OpenGL::isExtensionSupported("GL_ARB_base_instance")) {
+        LogWarn("GL_ARB_base_instance unavailable, instance attributes are repointed for every draw");
+    }
+
     if (OpenGL::isExtensionSupported("GL_ARB_seamless_cube_map")) {
-        glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+        stateCache.enable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
     } else {
         LogWarn("GL_ARB_seamless_cube_map unavailable, skybox may expose seams across faces");
     }
 
-    glEnable(GL_CULL_FACE);
+    stateCache.enable(GL_CULL_FACE);
     glFrontFace(GL_CW);
-    glCullFace(GL_BACK);
+    stateCache.cullFace(GL_BACK);
 
     // No visual effect for 32bit color bit context, not supported for non RGB frame buffers
-    glDisable(GL_DITHER);
+    stateCache.disable(GL_DITHER);
 
     // Skybox rendering, see skybox_output.shader
-    glDepthFunc(GL_LEQUAL);
+    stateCache.depthFunc(GL_LEQUAL);
 }
 
 void Engine::setupEngine() {
@@ -233,6 +257,7 @@ void Engine::setupEngine() {
     renderManager.getRenderState(RenderSkybox::ID)->setShader(objectManager.createShader("shaders/skybox_output.shader"));
     renderManager.getRenderState(RenderFrame::ID)->setShader(objectManager.createShader("shaders/ambient_lighting.shader"));
     renderManager.getRenderState(RenderLights::ID)->setShader(objectManager.createShader("shaders/deferred_lighting.shader"));
+    renderManager.getRenderState(RenderLightClusters::ID)->setShader(objectManager.createShader("shaders/clustered_lighting.shader"));
 
     this->onSetupSignal.connect(Signals::Slot<>(&Engine::onSetup, this));
     this->onTeardownSignal.connect(Signals::Slot<>(&Engine::onTeardown, this));
@@ -257,6 +282,8 @@ void Engine::teardownEngine() {
 
     GetRenderManager().teardown();
     GetObjectManager().teardown();
+    GetMaterialTable().teardown();
+    GetRenderTargetPool().teardown();
 }
 
 void Engine::update() {
@@ -264,11 +291,21 @@ void Engine::update() {
         scene->update(this->frameTime);
     }
 
+    // Single pass over all transformations changed during the scenes update
+    GetTransformStore().update();
+
+    auto& renderManager = GetRenderManager();
+    renderManager.beginFrame();
+
     for (auto& frameBuffer: this->frameBuffers) {
         frameBuffer->update();
     }
 
+    // Window viewports stream through the dynamic buffers as well
     this->window->update();
+    renderManager.endFrame();
+
+    GetRenderTargetPool().update();
 }
 
 void Engine::onSetupDebug() {
@@ -281,7 +318,7 @@ void Engine::onSetupDebug() {
     debugCamera->setNearPlane(-1.0f);  // NDC for 1:1 scale
     debugCamera->setFarPlane(1.0f);  // NDC for 1:1 scale
 
-    auto fpsLabel = objectManager.createLabel(150, 20, "fonts/dejavu-sans.ttf", 10);
+    auto fpsLabel = objectManager.createLabel(600, 20, "fonts/dejavu-sans.ttf", 10);
     debugRoot->addObject(debugCamera);
     debugRoot->addObject(fpsLabel);
 
@@ -308,8 +345,19 @@ void Engine::onIdleDebug() {
 
     int frameCount = this->frame % frameRange;
     if (frameCount == 0) {
+        auto& renderStats = GetRenderManager().getRenderStats();
+        int lightsCount = renderStats.visibleLights + renderStats.culledLights;
+
+        auto& stateCache = GetGLStateCache();
+        int stateCalls = stateCache.getIssuedCalls() + stateCache.getElidedCalls();
+
         std::wostringstream fpsText;
-        fpsText << L"FPS: " << static_cast<int>(fpsAverage);
+        fpsText << L"FPS: " << static_cast<int>(fpsAverage)
+                << L" Lights: " << renderStats.visibleLights << L"/" << lightsCount
+                << L" Occluded: " << renderStats.occludedEntities
+                << L" State: " << stateCache.getIssuedCalls() << L"/" << stateCalls
+                << L" Targets: " << GetRenderTargetPool().getPooledMemory() / (1024 * 1024) << L"MiB"
+                << L" Scale: " << static_cast<int>(this->window->getResolutionScale() * 100.0f) << L"%";
         this->fpsDebug->setText(fpsText.str());
 
         fpsAverage = 0.0f;
@@ -41,10 +41,15 @@ std::string EngineConfig::toString() const {
                  << FormatOption(30, "Antialiasing samples", this->samples)        << "\n"
                  << FormatOption(30, "Anisotropic filter level", this->anisotropy) << "\n"
                  << FormatOption(30, "FPS limit", this->maxFps)                    << "\n"
+                 << FormatOption(30, "Dynamic resolution", this->dynamicResolution) << "\n"
+                 << FormatOption(30, "Dynamic resolution FPS", this->targetFps)    << "\n"
+                 << FormatOption(30, "Minimum resolution scale", this->minResolutionScale) << "\n"
+                 << FormatOption(30, "Maximum resolution scale", this->maxResolutionScale) << "\n"
                  << FormatOption(30, "Vertical synchronization", this->vsync)      << "\n"
                  << FormatOption(30, "Fullscreen mode", this->fullscreen)          << "\n"
                  << FormatOption(30, "Debug output", this->debug)                  << "\n"
-                 << FormatOption(30, "Data directory", this->dataDirectory);
+                 << FormatOption(30, "Data directory", this->dataDirectory)        << "\n"
+                 << FormatOption(30, "Shader cache directory", this->shaderCacheDirectory);
 
     return configString.str();
 }
@@ -97,6 +102,38 @@ void EngineConfig::setMaxFps(float maxFps) {
     this->maxFps = maxFps;
 }
 
+bool EngineConfig::isDynamicResolution() const {
+    return this->dynamicResolution;
+}
+
+void EngineConfig::setDynamicResolution(bool dynamicResolution) {
+    this->dynamicResolution = dynamicResolution;
+}
+
+float EngineConfig::getTargetFps() const {
+    return this->targetFps;
+}
+
+void EngineConfig::setTargetFps(float targetFps) {
+    this->targetFps = targetFps;
+}
+
+float EngineConfig::getMinResolutionScale() const {
+    return this->minResolutionScale;
+}
+
+void EngineConfig::setMinResolutionScale(float minResolutionScale) {
+    this->minResolutionScale = minResolutionScale;
+}
+
+float EngineConfig::getMaxResolutionScale() const {
+    return this->maxResolutionScale;
+}
+
+void EngineConfig::setMaxResolutionScale(float maxResolutionScale) {
+    this->maxResolutionScale = maxResolutionScale;
+}
+
 bool EngineConfig::isVsync() const {
     return this->vsync;
 }
@@ -129,4 +166,12 @@ void EngineConfig::setDataDirectory(const std::string& directory) {
     this->dataDirectory = directory;
 }
 
+const std::string& EngineConfig::getShaderCacheDirectory() const {
+    return this->shaderCacheDirectory;
+}
+
+void EngineConfig::setShaderCacheDirectory(const std::string& directory) {
+    this->shaderCacheDirectory = directory;
+}
+
 }  // namespace Graphene
@@ -55,6 +55,18 @@ public:
     GRAPHENE_API float getMaxFps() const;
     GRAPHENE_API void setMaxFps(float maxFps);
 
+    GRAPHENE_API bool isDynamicResolution() const;
+    GRAPHENE_API void setDynamicResolution(bool dynamicResolution);
+
+    GRAPHENE_API float getTargetFps() const;
+    GRAPHENE_API void setTargetFps(float targetFps);  // Dynamic resolution frame rate to hold
+
+    GRAPHENE_API float getMinResolutionScale() const;
+    GRAPHENE_API void setMinResolutionScale(float minResolutionScale);
+
+    GRAPHENE_API float getMaxResolutionScale() const;
+    GRAPHENE_API void setMaxResolutionScale(float maxResolutionScale);
+
     GRAPHENE_API bool isVsync() const;
     GRAPHENE_API void setVsync(bool vsync);
 
@@ -67,6 +79,9 @@ public:
     GRAPHENE_API const std::string& getDataDirectory() const;
     GRAPHENE_API void setDataDirectory(const std::string& directory);
 
+    GRAPHENE_API const std::string& getShaderCacheDirectory() const;
+    GRAPHENE_API void setShaderCacheDirectory(const std::string& directory);  // Empty disables the cache
+
 private:
     EngineConfig() = default;
 
@@ -76,10 +91,15 @@ private:
     int samples = 0;        // TODO
     int anisotropy = 16;
     float maxFps = 0.0f;
+    bool dynamicResolution = false;
+    float targetFps = 60.0f;
+    float minResolutionScale = 0.5f;
+    float maxResolutionScale = 1.0f;
     bool vsync = false;
     bool fullscreen = false;
     bool debug = true;
     std::string dataDirectory;
+    std::string shaderCacheDirectory;
 };
 
 }  // namespace Graphene
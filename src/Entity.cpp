@@ -21,6 +21,7 @@
  */
 
 #include <Entity.h>
+#include <ObjectGroup.h>
 #include <Logger.h>
 #include <stdexcept>
 #include <algorithm>
@@ -39,6 +40,22 @@ bool Entity::isVisible() const {
     return this->visible;
 }
 
+void Entity::setOccluder(bool occluder) {
+    this->occluder = occluder;
+}
+
+bool Entity::isOccluder() const {
+    return this->occluder;
+}
+
+void Entity::setLayers(unsigned int layers) {
+    this->layers = layers;
+}
+
+unsigned int Entity::getLayers() const {
+    return this->layers;
+}
+
 const std::vector<std::shared_ptr<Component>>& Entity::getComponents() const {
     return this->components;
 }
@@ -50,6 +67,11 @@ void Entity::addComponent(const std::shared_ptr<Component>& component) {
 
     component->parent = this->toA<Entity>();
     this->components.emplace_back(component);
+
+    auto parentObject = this->getParent();
+    if (parentObject != nullptr) {
+        parentObject->invalidateBoundingBox();
+    }
 }
 
 void Entity::sendEvent(const std::shared_ptr<ComponentEvent>& event) const {
@@ -64,4 +86,21 @@ void Entity::update(float deltaTime) const {
     }
 }
 
+BoundingBox Entity::getBoundingBox() const {
+    BoundingBox boundingBox;
+    for (auto& component: this->components) {
+        boundingBox.merge(component->getBoundingBox());
+    }
+
+    return boundingBox;
+}
+
+Math::Mat4 Entity::getLocalTransformation() const {
+    return this->getTranslation() * this->getRotation() * this->getScaling();
+}
+
+void Entity::invalidateTransformation() {
+    Object::invalidateTransformation();
+}
+
 }  // namespace Graphene
@@ -27,8 +27,10 @@
 #include <Scalable.h>
 #include <Component.h>
 #include <ComponentEvent.h>
+#include <BoundingVolume.h>
 #include <MetaObject.h>
 #include <Object.h>
+#include <Mat4.h>
 #include <vector>
 #include <memory>
 #include <algorithm>
@@ -43,6 +45,12 @@ public:
     GRAPHENE_API void setVisible(bool visible);
     GRAPHENE_API bool isVisible() const;
 
+    GRAPHENE_API void setOccluder(bool occluder);  // Meshes with kept geometry rasterized for occlusion culling, see OcclusionBuffer
+    GRAPHENE_API bool isOccluder() const;
+
+    GRAPHENE_API void setLayers(unsigned int layers);  // Raycasts hit entities sharing a bit with their mask
+    GRAPHENE_API unsigned int getLayers() const;
+
     template<typename T>
     std::shared_ptr<T> getComponent() const;
 
@@ -52,8 +60,16 @@ public:
     GRAPHENE_API void sendEvent(const std::shared_ptr<ComponentEvent>& event) const;
     GRAPHENE_API void update(float deltaTime) const;
 
+    GRAPHENE_API BoundingBox getBoundingBox() const;  // In the entity's local space
+
+    GRAPHENE_API Math::Mat4 getLocalTransformation() const override;
+
 protected:
+    void invalidateTransformation() override;
+
     bool visible = true;
+    bool occluder = false;
+    unsigned int layers = 1;
 
     std::vector<std::shared_ptr<Component>> components;
 };
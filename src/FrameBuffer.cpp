@@ -22,51 +22,72 @@
 
 #include <FrameBuffer.h>
 #include <RenderManager.h>
+#include <GLStateCache.h>
+#include <RenderTargetPool.h>
 
 namespace Graphene {
 
 FrameBuffer::FrameBuffer(int width, int height, GLenum format):
         RenderTarget(width, height),
-        outputTexture(new Texture2D(width, height, format, 1)),
-        depthTexture(new DepthTexture(width, height)) {
+        outputTexture(new Texture2D(width, height, format, 1)) {
     glGenFramebuffers(1, &this->fbo);
 
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, this->fbo);
+    GetGLStateCache().bindFramebuffer(GL_DRAW_FRAMEBUFFER, this->fbo);
     glFramebufferTexture(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, this->outputTexture->getHandle(), 0);
-    glFramebufferTexture(GL_DRAW_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, this->depthTexture->getHandle(), 0);
+
+    // Draw buffers are the framebuffer state, set once
+    GLenum drawBuffers[] = { GL_COLOR_ATTACHMENT0 };
+    glDrawBuffers(1, drawBuffers);
 }
 
 FrameBuffer::~FrameBuffer() {
-    glDeleteFramebuffers(1, &this->fbo);
+    GetGLStateCache().deleteFramebuffer(this->fbo);
 }
 
 const std::shared_ptr<Texture>& FrameBuffer::getOutputTexture() const {
     return this->outputTexture;
 }
 
-const std::shared_ptr<DepthTexture>& FrameBuffer::getDepthTexture() const {
-    return this->depthTexture;
-}
-
 void FrameBuffer::getPixel(int x, int y, GLenum pixelFormat, GLenum pixelType, void* pixel) const {
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, this->fbo);
+    GetGLStateCache().bindFramebuffer(GL_READ_FRAMEBUFFER, this->fbo);
     glReadPixels(x, y, 1, 1, pixelFormat, pixelType, pixel);
 }
 
+int FrameBuffer::readPixels(int x, int y, int width, int height, GLenum pixelFormat, GLenum pixelType) {
+    return this->pixelReadback.read(this->fbo, x, y, width, height, pixelFormat, pixelType);
+}
+
+bool FrameBuffer::getPixels(int ticket, void* pixels) {
+    return this->pixelReadback.fetch(ticket, pixels);
+}
+
+void FrameBuffer::discardPixels(int ticket) {
+    this->pixelReadback.discard(ticket);
+}
+
 void FrameBuffer::update() {
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, this->fbo);
+    auto& renderTargetPool = GetRenderTargetPool();
+    auto depthTexture = renderTargetPool.acquireTexture(this->width, this->height, GL_DEPTH_COMPONENT24);
 
-    GLenum drawBuffers[] = { GL_COLOR_ATTACHMENT0 };
-    glDrawBuffers(1, drawBuffers);
+    auto& stateCache = GetGLStateCache();
+    stateCache.bindFramebuffer(GL_DRAW_FRAMEBUFFER, this->fbo);
+
+    // Usually the pool hands out the same texture again, attachment changes are costly
+    if (this->depthTexture.lock() != depthTexture) {
+        glFramebufferTexture(GL_DRAW_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depthTexture->getHandle(), 0);
+        this->depthTexture = depthTexture;
+    }
 
-    glDisable(GL_BLEND);
-    glEnable(GL_DEPTH_TEST);
+    stateCache.disable(GL_BLEND);
+    stateCache.enable(GL_DEPTH_TEST);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     for (auto& viewport: this->viewports) {
         GetRenderManager().setRenderState(RenderBuffer::ID);
         viewport->update();
     }
+
+    renderTargetPool.releaseTexture(depthTexture);
 }
 
 }  // namespace Graphene
@@ -26,6 +26,7 @@
 #include <GrapheneApi.h>
 #include <RenderTarget.h>
 #include <Texture.h>
+#include <PixelReadback.h>
 #include <OpenGL.h>
 #include <memory>
 
@@ -37,14 +38,20 @@ public:
     GRAPHENE_API ~FrameBuffer();
 
     GRAPHENE_API const std::shared_ptr<Texture>& getOutputTexture() const;
-    GRAPHENE_API const std::shared_ptr<DepthTexture>& getDepthTexture() const;
 
-    GRAPHENE_API void getPixel(int x, int y, GLenum pixelFormat, GLenum pixelType, void* pixel) const;
+    GRAPHENE_API void getPixel(int x, int y, GLenum pixelFormat, GLenum pixelType, void* pixel) const;  // Stalls, see readPixels()
+
+    // Region read without a stall, the ticket resolves a frame or two later
+    GRAPHENE_API int readPixels(int x, int y, int width, int height, GLenum pixelFormat, GLenum pixelType);
+    GRAPHENE_API bool getPixels(int ticket, void* pixels);  // False until resolved, the ticket is released once true
+    GRAPHENE_API void discardPixels(int ticket);
+
     GRAPHENE_API void update() override;
 
 private:
     std::shared_ptr<Texture> outputTexture;
-    std::shared_ptr<DepthTexture> depthTexture;
+    std::weak_ptr<Texture2D> depthTexture;  // Pooled, attached while updated
+    PixelReadback pixelReadback;
 };
 
 }  // namespace Graphene
@@ -0,0 +1,456 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <FrameGraph.h>
+#include <GLStateCache.h>
+#include <RenderTargetPool.h>
+#include <Logger.h>
+#include <stdexcept>
+#include <algorithm>
+
+#define FRAMEBUFFER_UNBOUND 0xFFFFFFFF
+
+namespace Graphene {
+
+static bool isDepthFormat(GLenum format) {
+    return format == GL_DEPTH_COMPONENT16 || format == GL_DEPTH_COMPONENT24 || format == GL_DEPTH_COMPONENT32F;
+}
+
+FrameGraph::~FrameGraph() {
+    auto& stateCache = GetGLStateCache();
+    for (auto& cachedFramebuffer: this->framebuffers) {
+        stateCache.deleteFramebuffer(cachedFramebuffer.framebuffer);
+    }
+
+    if (this->blitFramebuffer != 0) {
+        stateCache.deleteFramebuffer(this->blitFramebuffer);
+    }
+}
+
+FrameGraphResource FrameGraph::createTexture(const std::string& name, int width, int height, GLenum format) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument(LogFormat("Texture '%s' size is not positive", name.c_str()));
+    }
+
+    Resource resource = { };
+    resource.name = name;
+    resource.width = width;
+    resource.height = height;
+    resource.format = format;
+
+    this->resources.push_back(resource);
+    this->compiled = false;
+
+    return static_cast<FrameGraphResource>(this->resources.size() - 1);
+}
+
+FrameGraphResource FrameGraph::importFramebuffer(const std::string& name, GLuint framebuffer) {
+    Resource resource = { };
+    resource.name = name;
+    resource.framebuffer = framebuffer;
+    resource.imported = true;
+
+    this->resources.push_back(resource);
+    this->compiled = false;
+
+    return static_cast<FrameGraphResource>(this->resources.size() - 1);
+}
+
+int FrameGraph::addPass(const std::string& name, const PassHandler& handler) {
+    Pass pass = { };
+    pass.name = name;
+    pass.handler = handler;
+
+    this->passes.push_back(pass);
+    this->compiled = false;
+
+    return static_cast<int>(this->passes.size() - 1);
+}
+
+void FrameGraph::read(int pass, FrameGraphResource resource) {
+    this->checkPass(pass);
+    this->checkResource(resource);
+
+    this->passes[pass].reads.push_back(resource);
+    this->compiled = false;
+}
+
+void FrameGraph::write(int pass, FrameGraphResource resource) {
+    this->checkPass(pass);
+    this->checkResource(resource);
+
+    auto& writes = this->passes[pass].writes;
+    bool importedWrite = std::any_of(writes.begin(), writes.end(), [this](FrameGraphResource written) {
+        return this->resources[written].imported;
+    });
+
+    if (importedWrite || (!writes.empty() && this->resources[resource].imported)) {
+        throw std::invalid_argument(LogFormat("Pass '%s' mixes an imported framebuffer with other outputs",
+                this->passes[pass].name.c_str()));
+    }
+
+    writes.push_back(resource);
+    this->compiled = false;
+}
+
+void FrameGraph::compile() {
+    for (auto& resource: this->resources) {
+        resource.writers.clear();
+        resource.readers = 0;
+        resource.firstUse = -1;
+        resource.lastUse = -1;
+    }
+
+    int passesCount = static_cast<int>(this->passes.size());
+    for (int index = 0; index < passesCount; index++) {
+        auto& pass = this->passes[index];
+        pass.hasSideEffect = false;
+        pass.culled = false;
+        pass.references = static_cast<int>(pass.writes.size());
+
+        for (auto resource: pass.reads) {
+            this->resources[resource].readers++;
+        }
+
+        for (auto resource: pass.writes) {
+            this->resources[resource].writers.push_back(index);
+            pass.hasSideEffect |= this->resources[resource].imported;
+        }
+    }
+
+    // Cull passes whose outputs nobody reads, that may leave their inputs unread in turn
+    std::vector<FrameGraphResource> unreadResources;
+    for (size_t resource = 0; resource < this->resources.size(); resource++) {
+        if (this->resources[resource].readers == 0 && !this->resources[resource].imported) {
+            unreadResources.push_back(static_cast<FrameGraphResource>(resource));
+        }
+    }
+
+    while (!unreadResources.empty()) {
+        auto& resource = this->resources[unreadResources.back()];
+        unreadResources.pop_back();
+
+        for (auto writer: resource.writers) {
+            auto& pass = this->passes[writer];
+            if (pass.hasSideEffect || pass.culled || --pass.references > 0) {
+                continue;
+            }
+
+            pass.culled = true;
+            for (auto read: pass.reads) {
+                if (--this->resources[read].readers == 0 && !this->resources[read].imported) {
+                    unreadResources.push_back(read);
+                }
+            }
+        }
+    }
+
+    // Accesses in the declaration order define the dependencies: reads and writes wait
+    // for the preceding write, writes wait for the reads of the previous contents too
+    std::vector<std::vector<int>> dependents(passesCount);
+    std::vector<int> dependencies(passesCount, 0);
+
+    for (size_t resource = 0; resource < this->resources.size(); resource++) {
+        int lastWriter = -1;
+        std::vector<int> lastReaders;
+
+        for (int index = 0; index < passesCount; index++) {
+            auto& pass = this->passes[index];
+            if (pass.culled) {
+                continue;
+            }
+
+            bool reads = std::find(pass.reads.begin(), pass.reads.end(), resource) != pass.reads.end();
+            bool writes = std::find(pass.writes.begin(), pass.writes.end(), resource) != pass.writes.end();
+
+            if (reads && lastWriter == -1 && !this->resources[resource].imported) {
+                throw std::runtime_error(LogFormat("Pass '%s' reads '%s' before it is written",
+                        pass.name.c_str(), this->resources[resource].name.c_str()));
+            }
+
+            if ((reads || writes) && lastWriter != -1 && lastWriter != index) {
+                dependents[lastWriter].push_back(index);
+                dependencies[index]++;
+            }
+
+            if (writes) {
+                for (auto reader: lastReaders) {
+                    if (reader != index) {
+                        dependents[reader].push_back(index);
+                        dependencies[index]++;
+                    }
+                }
+
+                lastWriter = index;
+                lastReaders.clear();
+            } else if (reads) {
+                lastReaders.push_back(index);
+            }
+        }
+    }
+
+    // Prefer the ready pass writing the same outputs as the previous one to save a framebuffer
+    // switch, fall back to the declaration order which keeps transient lifetimes short
+    std::vector<int> readyPasses;
+    for (int index = 0; index < passesCount; index++) {
+        if (!this->passes[index].culled && dependencies[index] == 0) {
+            readyPasses.push_back(index);
+        }
+    }
+
+    this->passOrder.clear();
+    this->culledPasses = 0;
+
+    while (!readyPasses.empty()) {
+        auto next = std::min_element(readyPasses.begin(), readyPasses.end());
+        if (!this->passOrder.empty()) {
+            auto& previousWrites = this->passes[this->passOrder.back()].writes;
+            auto sameOutputs = std::find_if(readyPasses.begin(), readyPasses.end(), [this, &previousWrites](int index) {
+                return this->passes[index].writes == previousWrites;
+            });
+
+            if (sameOutputs != readyPasses.end()) {
+                next = sameOutputs;
+            }
+        }
+
+        int index = *next;
+        readyPasses.erase(next);
+        this->passOrder.push_back(index);
+
+        for (auto dependent: dependents[index]) {
+            if (--dependencies[dependent] == 0) {
+                readyPasses.push_back(dependent);
+            }
+        }
+    }
+
+    for (auto& pass: this->passes) {
+        this->culledPasses += pass.culled ? 1 : 0;
+    }
+
+    int position = 0;
+    for (auto index: this->passOrder) {
+        auto& pass = this->passes[index];
+        for (auto& accesses: { pass.reads, pass.writes }) {
+            for (auto resource: accesses) {
+                auto& used = this->resources[resource];
+                used.firstUse = (used.firstUse == -1) ? position : used.firstUse;
+                used.lastUse = position;
+            }
+        }
+
+        position++;
+    }
+
+    this->compiled = true;
+}
+
+void FrameGraph::execute() {
+    if (!this->compiled) {
+        this->compile();
+    }
+
+    auto& stateCache = GetGLStateCache();
+    auto& renderTargetPool = GetRenderTargetPool();
+
+    GLuint activeFramebuffer = FRAMEBUFFER_UNBOUND;
+    this->framebufferSwitches = 0;
+
+    for (int position = 0; position < static_cast<int>(this->passOrder.size()); position++) {
+        auto& pass = this->passes[this->passOrder[position]];
+
+        for (auto& resource: this->resources) {
+            if (!resource.imported && resource.firstUse == position) {
+                resource.texture = renderTargetPool.acquireTexture(resource.width, resource.height, resource.format);
+            }
+        }
+
+        GLuint framebuffer = this->getFramebuffer(pass);
+        if (framebuffer != activeFramebuffer) {
+            stateCache.bindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer);
+            activeFramebuffer = framebuffer;
+            this->framebufferSwitches++;
+        }
+
+        pass.handler(*this);
+
+        // Storage goes back to the pool right away, the following passes alias it
+        for (auto& resource: this->resources) {
+            if (!resource.imported && resource.lastUse == position) {
+                renderTargetPool.releaseTexture(resource.texture);
+                resource.texture.reset();
+            }
+        }
+    }
+}
+
+void FrameGraph::clear() {
+    this->resources.clear();
+    this->passes.clear();
+    this->passOrder.clear();
+
+    this->compiled = false;
+    this->culledPasses = 0;
+    this->framebufferSwitches = 0;
+}
+
+const std::shared_ptr<Texture2D>& FrameGraph::getTexture(FrameGraphResource resource) const {
+    this->checkResource(resource);
+
+    auto& texture = this->resources[resource].texture;
+    if (texture == nullptr) {
+        throw std::runtime_error(LogFormat("Texture '%s' is not allocated", this->resources[resource].name.c_str()));
+    }
+
+    return texture;
+}
+
+void FrameGraph::blitTexture(FrameGraphResource resource, int left, int top, int width, int height) const {
+    auto& texture = this->getTexture(resource);
+    if (isDepthFormat(this->resources[resource].format)) {
+        throw std::invalid_argument(LogFormat("Texture '%s' is not a color one", this->resources[resource].name.c_str()));
+    }
+
+    auto& stateCache = GetGLStateCache();
+    if (this->blitFramebuffer == 0) {
+        glGenFramebuffers(1, &this->blitFramebuffer);
+    }
+
+    // The draw side is the pass framebuffer bound by execute()
+    stateCache.bindFramebuffer(GL_READ_FRAMEBUFFER, this->blitFramebuffer);
+    glFramebufferTexture(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, texture->getHandle(), 0);
+    glBlitFramebuffer(0, 0, texture->getWidth(), texture->getHeight(), left, top, left + width, top + height,
+            GL_COLOR_BUFFER_BIT, GL_LINEAR);
+}
+
+const std::vector<int>& FrameGraph::getPassOrder() const {
+    return this->passOrder;
+}
+
+int FrameGraph::getCulledPasses() const {
+    return this->culledPasses;
+}
+
+int FrameGraph::getFramebufferSwitches() const {
+    return this->framebufferSwitches;
+}
+
+void FrameGraph::checkPass(int pass) const {
+    if (pass < 0 || pass >= static_cast<int>(this->passes.size())) {
+        throw std::invalid_argument(LogFormat("Pass %d does not exist", pass));
+    }
+}
+
+void FrameGraph::checkResource(FrameGraphResource resource) const {
+    if (resource < 0 || resource >= static_cast<int>(this->resources.size())) {
+        throw std::invalid_argument(LogFormat("Resource %d does not exist", resource));
+    }
+}
+
+GLuint FrameGraph::getFramebuffer(const Pass& pass) {
+    if (pass.writes.empty()) {
+        return 0;
+    }
+
+    if (this->resources[pass.writes[0]].imported) {
+        return this->resources[pass.writes[0]].framebuffer;
+    }
+
+    // Color attachments keep the declared order, the depth one goes last
+    std::vector<std::shared_ptr<Texture2D>> attachments;
+    std::shared_ptr<Texture2D> depthAttachment;
+
+    for (auto resource: pass.writes) {
+        auto& written = this->resources[resource];
+        if (isDepthFormat(written.format)) {
+            depthAttachment = written.texture;
+        } else {
+            attachments.push_back(written.texture);
+        }
+    }
+
+    size_t colorAttachments = attachments.size();
+    if (depthAttachment != nullptr) {
+        attachments.push_back(depthAttachment);
+    }
+
+    auto& stateCache = GetGLStateCache();
+
+    // Pooled textures freed meanwhile leave their framebuffers incomplete
+    this->framebuffers.erase(std::remove_if(this->framebuffers.begin(), this->framebuffers.end(), [&stateCache](const CachedFramebuffer& cachedFramebuffer) {
+        for (auto& attachment: cachedFramebuffer.attachments) {
+            if (attachment.expired()) {
+                stateCache.deleteFramebuffer(cachedFramebuffer.framebuffer);
+                return true;
+            }
+        }
+
+        return false;
+    }), this->framebuffers.end());
+
+    for (auto& cachedFramebuffer: this->framebuffers) {
+        if (cachedFramebuffer.colorAttachments != colorAttachments) {
+            continue;
+        }
+
+        bool sameAttachments = attachments.size() == cachedFramebuffer.attachments.size() &&
+                std::equal(attachments.begin(), attachments.end(), cachedFramebuffer.attachments.begin(),
+                [](const std::shared_ptr<Texture2D>& attachment, const std::weak_ptr<Texture2D>& cachedAttachment) {
+            return attachment == cachedAttachment.lock();
+        });
+
+        if (sameAttachments) {
+            return cachedFramebuffer.framebuffer;
+        }
+    }
+
+    CachedFramebuffer cachedFramebuffer = { };
+    cachedFramebuffer.colorAttachments = colorAttachments;
+    glGenFramebuffers(1, &cachedFramebuffer.framebuffer);
+    stateCache.bindFramebuffer(GL_DRAW_FRAMEBUFFER, cachedFramebuffer.framebuffer);
+
+    std::vector<GLenum> drawBuffers;
+    for (size_t attachment = 0; attachment < colorAttachments; attachment++) {
+        GLenum colorAttachment = GL_COLOR_ATTACHMENT0 + static_cast<GLenum>(attachment);
+        glFramebufferTexture(GL_DRAW_FRAMEBUFFER, colorAttachment, attachments[attachment]->getHandle(), 0);
+        drawBuffers.push_back(colorAttachment);
+    }
+
+    if (depthAttachment != nullptr) {
+        glFramebufferTexture(GL_DRAW_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depthAttachment->getHandle(), 0);
+    }
+
+    // Draw buffers are the framebuffer state, set once
+    if (drawBuffers.empty()) {
+        drawBuffers.push_back(GL_NONE);
+    }
+
+    glDrawBuffers(static_cast<GLsizei>(drawBuffers.size()), drawBuffers.data());
+
+    cachedFramebuffer.attachments.assign(attachments.begin(), attachments.end());
+    this->framebuffers.push_back(cachedFramebuffer);
+
+    return cachedFramebuffer.framebuffer;
+}
+
+}  // namespace Graphene
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FRAMEGRAPH_H
+#define FRAMEGRAPH_H
+
+#include <GrapheneApi.h>
+#include <NonCopyable.h>
+#include <Texture.h>
+#include <OpenGL.h>
+#include <functional>
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace Graphene {
+
+class FrameGraph;
+
+typedef int FrameGraphResource;
+typedef std::function<void(const FrameGraph& frameGraph)> PassHandler;
+
+/*
+ * Passes declare the resources they read and write, compile() orders them by their
+ * dependencies, culls passes nothing depends on and finds the transient textures lifetime.
+ * Transient textures come from the RenderTargetPool at the first use and go back after
+ * the last one, later passes reuse the same storage. Written textures are assembled into
+ * cached framebuffers, consecutive passes writing the same set do not switch framebuffers.
+ * Passes writing imported framebuffers are the graph outputs and never culled.
+ */
+class FrameGraph: public NonCopyable {
+public:
+    GRAPHENE_API FrameGraph() = default;
+    GRAPHENE_API ~FrameGraph();
+
+    GRAPHENE_API FrameGraphResource createTexture(const std::string& name, int width, int height, GLenum format);
+    GRAPHENE_API FrameGraphResource importFramebuffer(const std::string& name, GLuint framebuffer);
+
+    GRAPHENE_API int addPass(const std::string& name, const PassHandler& handler);
+    GRAPHENE_API void read(int pass, FrameGraphResource resource);
+    GRAPHENE_API void write(int pass, FrameGraphResource resource);  // Color attachments in the call order
+
+    GRAPHENE_API void compile();
+    GRAPHENE_API void execute();
+    GRAPHENE_API void clear();  // Keeps the cached framebuffers
+
+    GRAPHENE_API const std::shared_ptr<Texture2D>& getTexture(FrameGraphResource resource) const;  // While executed
+    GRAPHENE_API void blitTexture(FrameGraphResource resource, int left, int top, int width, int height) const;  // Into the pass output, filtered
+
+    GRAPHENE_API const std::vector<int>& getPassOrder() const;
+    GRAPHENE_API int getCulledPasses() const;
+    GRAPHENE_API int getFramebufferSwitches() const;
+
+private:
+    typedef struct {
+        std::string name;
+        int width;
+        int height;
+        GLenum format;
+        GLuint framebuffer;  // Imported only
+        bool imported;
+
+        std::vector<int> writers;
+        int readers;
+        int firstUse;
+        int lastUse;
+        std::shared_ptr<Texture2D> texture;
+    } Resource;
+
+    typedef struct {
+        std::string name;
+        PassHandler handler;
+        std::vector<FrameGraphResource> reads;
+        std::vector<FrameGraphResource> writes;
+        bool hasSideEffect;
+        bool culled;
+        int references;
+    } Pass;
+
+    typedef struct {
+        std::vector<std::weak_ptr<Texture2D>> attachments;  // Color ones, depth one if any
+        size_t colorAttachments;
+        GLuint framebuffer;
+    } CachedFramebuffer;
+
+    void checkPass(int pass) const;
+    void checkResource(FrameGraphResource resource) const;
+
+    GLuint getFramebuffer(const Pass& pass);
+
+    std::vector<Resource> resources;
+    std::vector<Pass> passes;
+    std::vector<int> passOrder;
+    std::vector<CachedFramebuffer> framebuffers;
+    mutable GLuint blitFramebuffer = 0;  // Read side of blitTexture(), created on demand
+
+    bool compiled = false;
+    int culledPasses = 0;
+    int framebufferSwitches = 0;
+};
+
+}  // namespace Graphene
+
+#endif  // FRAMEGRAPH_H
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <Frustum.h>
+#include <cmath>
+
+namespace Graphene {
+
+Frustum::Frustum(const Math::Mat4& modelViewProjection) {
+    // Clip space planes in terms of the source space, see G. Gribb, K. Hartmann,
+    // "Fast Extraction of Viewing Frustum Planes from the World-View-Projection Matrix", 2001
+    for (int column = 0; column < 4; column++) {
+        float w = modelViewProjection.get(3, column);
+
+        this->planes[PLANE_LEFT][column] = w + modelViewProjection.get(0, column);
+        this->planes[PLANE_RIGHT][column] = w - modelViewProjection.get(0, column);
+        this->planes[PLANE_BOTTOM][column] = w + modelViewProjection.get(1, column);
+        this->planes[PLANE_TOP][column] = w - modelViewProjection.get(1, column);
+        this->planes[PLANE_NEAR][column] = w + modelViewProjection.get(2, column);
+        this->planes[PLANE_FAR][column] = w - modelViewProjection.get(2, column);
+    }
+
+    for (auto& plane: this->planes) {
+        float length = sqrtf(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+        if (length > 0.0f) {
+            for (auto& coefficient: plane) {
+                coefficient /= length;
+            }
+        }
+    }
+}
+
+Math::Vec4 Frustum::getPlane(FrustumPlane plane) const {
+    auto& coefficients = this->planes[plane];
+    return Math::Vec4(coefficients[0], coefficients[1], coefficients[2], coefficients[3]);
+}
+
+bool Frustum::intersects(const BoundingBox& box) const {
+    if (box.isEmpty()) {
+        return false;
+    }
+
+    Math::Vec3 center(box.getCenter());
+    Math::Vec3 extents(box.getExtents());
+
+    float cx = center.get(Math::Vec3::X);
+    float cy = center.get(Math::Vec3::Y);
+    float cz = center.get(Math::Vec3::Z);
+    float ex = extents.get(Math::Vec3::X);
+    float ey = extents.get(Math::Vec3::Y);
+    float ez = extents.get(Math::Vec3::Z);
+
+    for (auto& plane: this->planes) {
+        // Distance of the box corner farthest along the plane normal
+        float distance = plane[0] * cx + plane[1] * cy + plane[2] * cz + plane[3];
+        float radius = fabsf(plane[0]) * ex + fabsf(plane[1]) * ey + fabsf(plane[2]) * ez;
+
+        if (distance + radius < 0.0f) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool Frustum::contains(const BoundingBox& box) const {
+    if (box.isEmpty()) {
+        return false;
+    }
+
+    Math::Vec3 center(box.getCenter());
+    Math::Vec3 extents(box.getExtents());
+
+    float cx = center.get(Math::Vec3::X);
+    float cy = center.get(Math::Vec3::Y);
+    float cz = center.get(Math::Vec3::Z);
+    float ex = extents.get(Math::Vec3::X);
+    float ey = extents.get(Math::Vec3::Y);
+    float ez = extents.get(Math::Vec3::Z);
+
+    for (auto& plane: this->planes) {
+        // Distance of the box corner nearest along the plane normal
+        float distance = plane[0] * cx + plane[1] * cy + plane[2] * cz + plane[3];
+        float radius = fabsf(plane[0]) * ex + fabsf(plane[1]) * ey + fabsf(plane[2]) * ez;
+
+        if (distance - radius < 0.0f) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool Frustum::intersects(const BoundingSphere& sphere) const {
+    if (sphere.isEmpty()) {
+        return false;
+    }
+
+    auto& center = sphere.getCenter();
+    float cx = center.get(Math::Vec3::X);
+    float cy = center.get(Math::Vec3::Y);
+    float cz = center.get(Math::Vec3::Z);
+
+    for (auto& plane: this->planes) {
+        float distance = plane[0] * cx + plane[1] * cy + plane[2] * cz + plane[3];
+
+        if (distance + sphere.getRadius() < 0.0f) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}  // namespace Graphene
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <GrapheneApi.h>
+#include <BoundingVolume.h>
+#include <Mat4.h>
+#include <Vec4.h>
+
+namespace Graphene {
+
+enum FrustumPlane { PLANE_LEFT, PLANE_RIGHT, PLANE_BOTTOM, PLANE_TOP, PLANE_NEAR, PLANE_FAR };
+
+class Frustum {
+public:
+    GRAPHENE_API Frustum(const Math::Mat4& modelViewProjection);
+
+    GRAPHENE_API Math::Vec4 getPlane(FrustumPlane plane) const;
+
+    GRAPHENE_API bool intersects(const BoundingBox& box) const;
+    GRAPHENE_API bool intersects(const BoundingSphere& sphere) const;
+    GRAPHENE_API bool contains(const BoundingBox& box) const;
+
+private:
+    float planes[6][4];  // Normalized (a, b, c, d) with normals pointing inside
+};
+
+}  // namespace Graphene
+
+#endif  // FRUSTUM_H
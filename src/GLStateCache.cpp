@@ -0,0 +1,345 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <GLStateCache.h>
+
+#define GLSTATE_UNKNOWN 0xFFFFFFFF  // Neither a valid name nor a valid enum
+
+namespace Graphene {
+
+GLStateCache& GLStateCache::getInstance() {
+    static GLStateCache instance;
+    return instance;
+}
+
+GLStateCache::GLStateCache() {
+    this->invalidate();
+}
+
+void GLStateCache::enable(GLenum capability) {
+    this->setCapability(capability, true);
+}
+
+void GLStateCache::disable(GLenum capability) {
+    this->setCapability(capability, false);
+}
+
+void GLStateCache::blendFunc(GLenum sourceFactor, GLenum destinationFactor) {
+    if (this->blendSource == sourceFactor && this->blendDestination == destinationFactor) {
+        this->elidedCalls++;
+        return;
+    }
+
+    glBlendFunc(sourceFactor, destinationFactor);
+    this->blendSource = sourceFactor;
+    this->blendDestination = destinationFactor;
+    this->issuedCalls++;
+}
+
+void GLStateCache::depthFunc(GLenum function) {
+    if (this->update(this->depthFunction, function)) {
+        glDepthFunc(function);
+    }
+}
+
+void GLStateCache::depthMask(GLboolean enabled) {
+    if (this->update(this->depthWrites, enabled)) {
+        glDepthMask(enabled);
+    }
+}
+
+void GLStateCache::colorMask(GLboolean enabled) {
+    if (this->update(this->colorWrites, enabled)) {
+        glColorMask(enabled, enabled, enabled, enabled);
+    }
+}
+
+void GLStateCache::cullFace(GLenum mode) {
+    if (this->update(this->cullMode, mode)) {
+        glCullFace(mode);
+    }
+}
+
+void GLStateCache::scissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+    if (this->scissorBox[0] == x && this->scissorBox[1] == y && this->scissorBox[2] == width && this->scissorBox[3] == height) {
+        this->elidedCalls++;
+        return;
+    }
+
+    glScissor(x, y, width, height);
+    this->scissorBox[0] = x;
+    this->scissorBox[1] = y;
+    this->scissorBox[2] = width;
+    this->scissorBox[3] = height;
+    this->issuedCalls++;
+}
+
+void GLStateCache::bindFramebuffer(GLenum target, GLuint framebuffer) {
+    if (target == GL_FRAMEBUFFER) {
+        if (this->drawFramebuffer == framebuffer && this->readFramebuffer == framebuffer) {
+            this->elidedCalls++;
+            return;
+        }
+
+        glBindFramebuffer(target, framebuffer);
+        this->drawFramebuffer = framebuffer;
+        this->readFramebuffer = framebuffer;
+        this->issuedCalls++;
+        return;
+    }
+
+    GLuint& shadowed = (target == GL_READ_FRAMEBUFFER) ? this->readFramebuffer : this->drawFramebuffer;
+    if (this->update(shadowed, framebuffer)) {
+        glBindFramebuffer(target, framebuffer);
+    }
+}
+
+void GLStateCache::useProgram(GLuint program) {
+    if (this->update(this->program, program)) {
+        glUseProgram(program);
+    }
+}
+
+void GLStateCache::bindVertexArray(GLuint vertexArray) {
+    if (this->update(this->vertexArray, vertexArray)) {
+        glBindVertexArray(vertexArray);
+
+        // Element array binding is the VAO state
+        for (auto& binding: this->buffers) {
+            if (binding.target == GL_ELEMENT_ARRAY_BUFFER) {
+                binding.buffer = GLSTATE_UNKNOWN;
+            }
+        }
+    }
+}
+
+void GLStateCache::bindBuffer(GLenum target, GLuint buffer) {
+    for (auto& binding: this->buffers) {
+        if (binding.target == target || binding.target == GLSTATE_UNKNOWN) {
+            binding.target = target;
+            if (this->update(binding.buffer, buffer)) {
+                glBindBuffer(target, buffer);
+            }
+
+            return;
+        }
+    }
+
+    glBindBuffer(target, buffer);  // Out of slots, not cached
+    this->issuedCalls++;
+}
+
+void GLStateCache::bindBufferBase(GLenum target, GLuint index, GLuint buffer) {
+    // Whole buffer range, see glBindBufferBase()
+    this->bindBufferRange(target, index, buffer, 0, 0);
+}
+
+void GLStateCache::bindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) {
+    for (auto& binding: this->indexedBuffers) {
+        if (binding.target == GLSTATE_UNKNOWN) {
+            binding.target = target;
+            binding.index = index;
+            binding.buffer = GLSTATE_UNKNOWN;
+        } else if (binding.target != target || binding.index != index) {
+            continue;
+        }
+
+        if (binding.buffer == buffer && binding.offset == offset && binding.size == size) {
+            this->elidedCalls++;
+            return;
+        }
+
+        binding.buffer = buffer;
+        binding.offset = offset;
+        binding.size = size;
+        break;
+    }
+
+    if (size == 0) {
+        glBindBufferBase(target, index, buffer);
+    } else {
+        glBindBufferRange(target, index, buffer, offset, size);
+    }
+
+    // Indexed binding replaces the generic binding as well
+    for (auto& binding: this->buffers) {
+        if (binding.target == target) {
+            binding.buffer = buffer;
+            break;
+        }
+    }
+
+    this->issuedCalls++;
+}
+
+void GLStateCache::bindTexture(GLuint unit, GLenum target, GLuint texture) {
+    if (unit < GLSTATE_TEXTURE_UNITS_MAX) {
+        auto& binding = this->textures[unit];
+        if (binding.target == target && binding.texture == texture) {
+            this->elidedCalls++;
+            return;
+        }
+
+        binding.target = target;
+        binding.texture = texture;
+    }
+
+    if (this->update(this->activeUnit, unit)) {
+        glActiveTexture(GL_TEXTURE0 + unit);
+    }
+
+    glBindTexture(target, texture);
+    this->issuedCalls++;
+}
+
+void GLStateCache::deleteFramebuffer(GLuint framebuffer) {
+    glDeleteFramebuffers(1, &framebuffer);
+
+    if (this->drawFramebuffer == framebuffer) {
+        this->drawFramebuffer = 0;
+    }
+
+    if (this->readFramebuffer == framebuffer) {
+        this->readFramebuffer = 0;
+    }
+}
+
+void GLStateCache::deleteVertexArray(GLuint vertexArray) {
+    glDeleteVertexArrays(1, &vertexArray);
+
+    if (this->vertexArray == vertexArray) {
+        this->vertexArray = 0;
+    }
+}
+
+void GLStateCache::deleteBuffer(GLuint buffer) {
+    glDeleteBuffers(1, &buffer);
+
+    for (auto& binding: this->buffers) {
+        if (binding.buffer == buffer) {
+            binding.buffer = 0;
+        }
+    }
+
+    for (auto& binding: this->indexedBuffers) {
+        if (binding.buffer == buffer) {
+            binding.buffer = 0;
+        }
+    }
+}
+
+void GLStateCache::deleteTexture(GLuint texture) {
+    glDeleteTextures(1, &texture);
+
+    for (auto& binding: this->textures) {
+        if (binding.texture == texture) {
+            binding.texture = 0;
+        }
+    }
+}
+
+void GLStateCache::invalidate() {
+    for (auto& entry: this->capabilities) {
+        entry.capability = GLSTATE_UNKNOWN;
+    }
+
+    for (auto& binding: this->buffers) {
+        binding.target = GLSTATE_UNKNOWN;
+    }
+
+    for (auto& binding: this->indexedBuffers) {
+        binding.target = GLSTATE_UNKNOWN;
+    }
+
+    for (auto& binding: this->textures) {
+        binding.target = GLSTATE_UNKNOWN;
+        binding.texture = GLSTATE_UNKNOWN;
+    }
+
+    this->blendSource = GLSTATE_UNKNOWN;
+    this->blendDestination = GLSTATE_UNKNOWN;
+    this->depthFunction = GLSTATE_UNKNOWN;
+    this->depthWrites = GLSTATE_UNKNOWN;
+    this->colorWrites = GLSTATE_UNKNOWN;
+    this->cullMode = GLSTATE_UNKNOWN;
+
+    // Negative size is never a valid box
+    this->scissorBox[0] = 0;
+    this->scissorBox[1] = 0;
+    this->scissorBox[2] = -1;
+    this->scissorBox[3] = -1;
+
+    this->drawFramebuffer = GLSTATE_UNKNOWN;
+    this->readFramebuffer = GLSTATE_UNKNOWN;
+    this->program = GLSTATE_UNKNOWN;
+    this->vertexArray = GLSTATE_UNKNOWN;
+    this->activeUnit = GLSTATE_UNKNOWN;
+}
+
+int GLStateCache::getIssuedCalls() const {
+    return this->issuedCalls;
+}
+
+int GLStateCache::getElidedCalls() const {
+    return this->elidedCalls;
+}
+
+void GLStateCache::resetCounters() {
+    this->issuedCalls = 0;
+    this->elidedCalls = 0;
+}
+
+bool GLStateCache::update(GLuint& shadowed, GLuint value) {
+    if (shadowed == value) {
+        this->elidedCalls++;
+        return false;
+    }
+
+    shadowed = value;
+    this->issuedCalls++;
+    return true;
+}
+
+void GLStateCache::setCapability(GLenum capability, bool enabled) {
+    for (auto& entry: this->capabilities) {
+        if (entry.capability == capability || entry.capability == GLSTATE_UNKNOWN) {
+            if (entry.capability == capability && entry.enabled == enabled) {
+                this->elidedCalls++;
+                return;
+            }
+
+            entry.capability = capability;
+            entry.enabled = enabled;
+            break;
+        }
+    }
+
+    if (enabled) {
+        glEnable(capability);
+    } else {
+        glDisable(capability);
+    }
+
+    this->issuedCalls++;
+}
+
+}  // namespace Graphene
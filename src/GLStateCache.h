@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef GLSTATECACHE_H
+#define GLSTATECACHE_H
+
+#include <GrapheneApi.h>
+#include <NonCopyable.h>
+#include <OpenGL.h>
+
+#define GetGLStateCache() GLStateCache::getInstance()
+
+#define GLSTATE_CAPABILITIES_MAX 16
+#define GLSTATE_BUFFER_TARGETS_MAX 8
+#define GLSTATE_INDEXED_BUFFERS_MAX 16
+#define GLSTATE_TEXTURE_UNITS_MAX 16
+
+namespace Graphene {
+
+/*
+ * Shadow copy of the context state, calls matching the shadowed value are not issued.
+ * Everything binding or toggling tracked state has to go through the cache, state
+ * changed behind its back has to be followed by invalidate().
+ */
+class GLStateCache: public NonCopyable {
+public:
+    GRAPHENE_API static GLStateCache& getInstance();
+
+    GRAPHENE_API void enable(GLenum capability);
+    GRAPHENE_API void disable(GLenum capability);
+
+    GRAPHENE_API void blendFunc(GLenum sourceFactor, GLenum destinationFactor);
+    GRAPHENE_API void depthFunc(GLenum function);
+    GRAPHENE_API void depthMask(GLboolean enabled);
+    GRAPHENE_API void colorMask(GLboolean enabled);  // All channels at once
+    GRAPHENE_API void cullFace(GLenum mode);
+    GRAPHENE_API void scissor(GLint x, GLint y, GLsizei width, GLsizei height);
+
+    GRAPHENE_API void bindFramebuffer(GLenum target, GLuint framebuffer);
+    GRAPHENE_API void useProgram(GLuint program);
+    GRAPHENE_API void bindVertexArray(GLuint vertexArray);
+
+    GRAPHENE_API void bindBuffer(GLenum target, GLuint buffer);
+    GRAPHENE_API void bindBufferBase(GLenum target, GLuint index, GLuint buffer);
+    GRAPHENE_API void bindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+
+    GRAPHENE_API void bindTexture(GLuint unit, GLenum target, GLuint texture);
+
+    // Deleting a bound object reverts its bindings to zero
+    GRAPHENE_API void deleteFramebuffer(GLuint framebuffer);
+    GRAPHENE_API void deleteVertexArray(GLuint vertexArray);
+    GRAPHENE_API void deleteBuffer(GLuint buffer);
+    GRAPHENE_API void deleteTexture(GLuint texture);
+
+    GRAPHENE_API void invalidate();
+
+    GRAPHENE_API int getIssuedCalls() const;
+    GRAPHENE_API int getElidedCalls() const;
+    GRAPHENE_API void resetCounters();
+
+private:
+    GLStateCache();
+
+    bool update(GLuint& shadowed, GLuint value);
+    void setCapability(GLenum capability, bool enabled);
+
+    // Plain arrays only, the instance may be reached by the destructors of other singletons
+    struct {
+        GLenum capability;
+        int enabled;
+    } capabilities[GLSTATE_CAPABILITIES_MAX];
+
+    struct {
+        GLenum target;
+        GLuint buffer;
+    } buffers[GLSTATE_BUFFER_TARGETS_MAX];
+
+    struct {
+        GLenum target;
+        GLuint index;
+        GLuint buffer;
+        GLintptr offset;
+        GLsizeiptr size;
+    } indexedBuffers[GLSTATE_INDEXED_BUFFERS_MAX];
+
+    struct {
+        GLenum target;
+        GLuint texture;
+    } textures[GLSTATE_TEXTURE_UNITS_MAX];
+
+    GLuint blendSource;
+    GLuint blendDestination;
+    GLuint depthFunction;
+    GLuint depthWrites;
+    GLuint colorWrites;
+    GLuint cullMode;
+    GLint scissorBox[4];
+
+    GLuint drawFramebuffer;
+    GLuint readFramebuffer;
+    GLuint program;
+    GLuint vertexArray;
+    GLuint activeUnit;
+
+    int issuedCalls = 0;
+    int elidedCalls = 0;
+};
+
+}  // namespace Graphene
+
+#endif  // GLSTATECACHE_H
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <GpuTimer.h>
+
+namespace Graphene {
+
+GpuTimer::GpuTimer() {
+    glGenQueries(GPU_TIMER_QUERIES, this->queries);
+}
+
+GpuTimer::~GpuTimer() {
+    glDeleteQueries(GPU_TIMER_QUERIES, this->queries);
+}
+
+void GpuTimer::begin() {
+    this->active = this->pendingQueries < GPU_TIMER_QUERIES;
+    if (!this->active) {
+        return;
+    }
+
+    int query = (this->oldestQuery + this->pendingQueries) % GPU_TIMER_QUERIES;
+    glBeginQuery(GL_TIME_ELAPSED, this->queries[query]);
+}
+
+void GpuTimer::end() {
+    if (!this->active) {
+        return;
+    }
+
+    glEndQuery(GL_TIME_ELAPSED);
+    this->pendingQueries++;
+    this->active = false;
+}
+
+bool GpuTimer::poll() {
+    bool polled = false;
+
+    while (this->pendingQueries > 0) {
+        GLuint query = this->queries[this->oldestQuery];
+
+        GLint available = GL_FALSE;
+        glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available == GL_FALSE) {
+            break;
+        }
+
+        GLuint64 elapsedTime = 0;
+        glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsedTime);
+        this->elapsedTime = static_cast<float>(elapsedTime) / 1000000.0f;
+
+        this->oldestQuery = (this->oldestQuery + 1) % GPU_TIMER_QUERIES;
+        this->pendingQueries--;
+        polled = true;
+    }
+
+    return polled;
+}
+
+float GpuTimer::getElapsedTime() const {
+    return this->elapsedTime;
+}
+
+}  // namespace Graphene
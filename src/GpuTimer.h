@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef GPUTIMER_H
+#define GPUTIMER_H
+
+#include <GrapheneApi.h>
+#include <NonCopyable.h>
+#include <OpenGL.h>
+
+#define GPU_TIMER_QUERIES 4  // Frames in flight, results are read without waiting
+
+namespace Graphene {
+
+/*
+ * GL_TIME_ELAPSED queries in a ring. Results come a few frames late, a frame finding every
+ * query still in flight goes unmeasured rather than stalling on the oldest one.
+ */
+class GpuTimer: public NonCopyable {
+public:
+    GRAPHENE_API GpuTimer();
+    GRAPHENE_API ~GpuTimer();
+
+    GRAPHENE_API void begin();
+    GRAPHENE_API void end();
+
+    GRAPHENE_API bool poll();  // True if a new result is available
+    GRAPHENE_API float getElapsedTime() const;  // Milliseconds, the latest result
+
+private:
+    GLuint queries[GPU_TIMER_QUERIES] = { };
+    int oldestQuery = 0;
+    int pendingQueries = 0;
+    bool active = false;
+
+    float elapsedTime = 0.0f;
+};
+
+}  // namespace Graphene
+
+#endif  // GPUTIMER_H
@@ -21,6 +21,8 @@
  */
 
 #include <GraphicsComponent.h>
+#include <Entity.h>
+#include <ObjectGroup.h>
 #include <Logger.h>
 #include <stdexcept>
 #include <cassert>
@@ -50,6 +52,25 @@ void GraphicsComponent::addGraphics(const std::shared_ptr<Material>& material, c
 
     this->materials.emplace_back(material);
     this->meshes.emplace_back(mesh);
+
+    this->boundingBox.merge(mesh->getBoundingBox());
+    this->boundingSphere.merge(mesh->getBoundingSphere());
+
+    auto entity = this->getParent();
+    if (entity != nullptr) {
+        auto objectGroup = entity->getParent();
+        if (objectGroup != nullptr) {
+            objectGroup->invalidateBoundingBox();
+        }
+    }
+}
+
+BoundingBox GraphicsComponent::getBoundingBox() const {
+    return this->boundingBox;
+}
+
+const BoundingSphere& GraphicsComponent::getBoundingSphere() const {
+    return this->boundingSphere;
 }
 
 void GraphicsComponent::render() {
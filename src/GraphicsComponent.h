@@ -28,6 +28,7 @@
 #include <Component.h>
 #include <Material.h>
 #include <Mesh.h>
+#include <BoundingVolume.h>
 #include <vector>
 #include <memory>
 
@@ -46,9 +47,15 @@ public:
     GRAPHENE_API void receiveEvent(const std::shared_ptr<ComponentEvent>& event) override;
     GRAPHENE_API void update(float /*deltaTime*/) override { };
 
+    GRAPHENE_API BoundingBox getBoundingBox() const override;
+    GRAPHENE_API const BoundingSphere& getBoundingSphere() const;
+
 private:
     std::vector<std::shared_ptr<Material>> materials;
     std::vector<std::shared_ptr<Mesh>> meshes;
+
+    BoundingBox boundingBox;
+    BoundingSphere boundingSphere;
 };
 
 }  // namespace Graphene
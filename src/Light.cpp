@@ -26,8 +26,12 @@
 #include <Mat3.h>
 #include <Mat4.h>
 #include <stdexcept>
+#include <algorithm>
+#include <limits>
 #include <cmath>
 
+#define LIGHT_CUTOFF (1.0f / 256.0f)  // Contribution below 8 bit per channel precision
+
 namespace Graphene {
 
 #pragma pack(push, 1)
@@ -78,6 +82,52 @@ void Light::setFalloff(float falloff) {
     this->parametersDirty = true;
 }
 
+float Light::getRange() const {
+    if (this->lightType == LightType::DIRECTED) {
+        return std::numeric_limits<float>::infinity();
+    }
+
+    /*
+     * Attenuation is F^2 / (F^2 + D^2), see deferred_lighting.shader. Range is the distance D
+     * the brightest channel scaled by energy E and attenuation drops to LIGHT_CUTOFF at:
+     *     E * F^2 / (F^2 + D^2) = LIGHT_CUTOFF
+     *     D = F * sqrt(E / LIGHT_CUTOFF - 1)
+     */
+
+    float brightness = std::max({ this->color.get(Math::Vec3::X), this->color.get(Math::Vec3::Y), this->color.get(Math::Vec3::Z) });
+    float intensity = this->energy * brightness;
+
+    if (intensity <= LIGHT_CUTOFF) {
+        return 0.0f;
+    }
+
+    return this->falloff * sqrtf(intensity / LIGHT_CUTOFF - 1.0f);
+}
+
+BoundingSphere Light::getBoundingSphere(const Math::Vec3& position, const Math::Vec3& direction) const {
+    float range = this->getRange();
+    if (this->lightType != LightType::SPOT) {
+        return BoundingSphere(position, range);  // Infinite for DIRECTED, never culled
+    }
+
+    /*
+     * Smallest sphere around a cone of length R and half angle A. Wide cones are bounded by
+     * the circle of the cap, narrow ones by the sphere through the apex and the cap rim:
+     *     A > 45: center = P + D * R * cos(A), radius = R * sin(A)
+     *     A <= 45: center = P + D * R / (2 * cos(A)), radius = R / (2 * cos(A))
+     */
+
+    float halfAngle = this->angle * static_cast<float>(M_PI) / 360.0f;
+    float cosine = cosf(halfAngle);
+
+    if (halfAngle > static_cast<float>(M_PI) / 4.0f) {
+        return BoundingSphere(position + direction * (range * cosine), range * sinf(halfAngle));
+    }
+
+    float radius = range / (2.0f * cosine);
+    return BoundingSphere(position + direction * radius, radius);
+}
+
 float Light::getAngle() const {
     return this->angle;
 }
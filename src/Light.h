@@ -27,6 +27,7 @@
 #include <UniformBuffer.h>
 #include <MetaObject.h>
 #include <Object.h>
+#include <BoundingVolume.h>
 #include <Vec3.h>
 #include <memory>
 
@@ -47,6 +48,9 @@ public:
     GRAPHENE_API float getFalloff() const;
     GRAPHENE_API void setFalloff(float falloff);
 
+    GRAPHENE_API float getRange() const;  // Distance the light has visible contribution within
+    GRAPHENE_API BoundingSphere getBoundingSphere(const Math::Vec3& position, const Math::Vec3& direction) const;
+
     GRAPHENE_API float getAngle() const;
     GRAPHENE_API void setAngle(float angle);
 
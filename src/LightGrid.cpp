@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <LightGrid.h>
+#include <Logger.h>
+#include <Vec4.h>
+#include <algorithm>
+#include <initializer_list>
+#include <stdexcept>
+#include <limits>
+#include <cmath>
+
+namespace Graphene {
+
+LightGrid::LightGrid(int width, int height, int depth):
+        width(width),
+        height(height),
+        depth(depth) {
+    if (width <= 0 || height <= 0 || depth <= 0) {
+        throw std::invalid_argument(LogFormat("Grid dimensions are less or equal zero"));
+    }
+}
+
+int LightGrid::getWidth() const {
+    return this->width;
+}
+
+int LightGrid::getHeight() const {
+    return this->height;
+}
+
+int LightGrid::getDepth() const {
+    return this->depth;
+}
+
+float LightGrid::getDepthScale() const {
+    return this->depthScale;
+}
+
+float LightGrid::getDepthBias() const {
+    return this->depthBias;
+}
+
+void LightGrid::update(const std::shared_ptr<Camera>& camera, const Math::Mat4& modelView,
+        const std::vector<BoundingSphere>& lightVolumes) {
+    if (camera->getProjectionType() != ProjectionType::PERSPECTIVE) {
+        throw std::invalid_argument(LogFormat("Light grid requires perspective projection"));
+    }
+
+    float nearPlane = camera->getNearPlane();
+    float farPlane = camera->getFarPlane();
+    float depthRange = logf(farPlane / nearPlane);
+
+    this->depthScale = this->depth / depthRange;
+    this->depthBias = -this->depth * logf(nearPlane) / depthRange;
+
+    std::vector<float> slices(this->depth + 1);
+    for (int slice = 0; slice <= this->depth; slice++) {
+        slices[slice] = nearPlane * powf(farPlane / nearPlane, static_cast<float>(slice) / this->depth);
+    }
+
+    auto findSlice = [this](float viewDepth) {
+        int slice = static_cast<int>(floorf(logf(viewDepth) * this->depthScale + this->depthBias));
+        return std::min(std::max(slice, 0), this->depth - 1);
+    };
+
+    auto& projection = camera->getProjection();
+    float scaleX = projection.get(0, 0);
+    float scaleY = projection.get(1, 1);
+
+    struct LightRange {
+        int light;
+        int slice;
+        CellRange range;
+    };
+
+    int cellsCount = this->width * this->height * this->depth;
+    std::vector<unsigned int> counts(cellsCount, 0);
+    std::vector<LightRange> lightRanges;
+
+    for (size_t light = 0; light < lightVolumes.size(); light++) {
+        auto& lightVolume = lightVolumes[light];
+        if (lightVolume.isEmpty()) {
+            continue;
+        }
+
+        Math::Vec3 center(Math::Vec4(modelView * Math::Vec4(lightVolume.getCenter(), 1.0f)).extractVec3());
+        float radius = lightVolume.getRadius();
+        float centerDepth = center.get(Math::Vec3::Z);
+
+        float nearDepth = std::max(centerDepth - radius, nearPlane);
+        float farDepth = std::min(centerDepth + radius, farPlane);
+        if (nearDepth > farDepth) {
+            continue;  // Behind the near plane or beyond the far plane
+        }
+
+        int lastSlice = findSlice(farDepth);
+        for (int slice = findSlice(nearDepth); slice <= lastSlice; slice++) {
+            float sliceNear = std::max(nearDepth, slices[slice]);
+            float sliceFar = std::min(farDepth, slices[slice + 1]);
+
+            CellRange range;
+            if (!this->calculateRange(center, radius, sliceNear, sliceFar, scaleX, scaleY, range)) {
+                continue;
+            }
+
+            for (int y = range.minY; y <= range.maxY; y++) {
+                for (int x = range.minX; x <= range.maxX; x++) {
+                    counts[(slice * this->height + y) * this->width + x]++;
+                }
+            }
+
+            lightRanges.push_back({ static_cast<int>(light), slice, range });
+        }
+    }
+
+    this->cells.resize(cellsCount * 2);
+
+    unsigned int offset = 0;
+    for (int cell = 0; cell < cellsCount; cell++) {
+        this->cells[cell * 2] = offset;
+        this->cells[cell * 2 + 1] = 0;
+        offset += counts[cell];
+    }
+
+    this->indices.resize(offset);
+
+    for (auto& lightRange: lightRanges) {
+        auto& range = lightRange.range;
+
+        for (int y = range.minY; y <= range.maxY; y++) {
+            for (int x = range.minX; x <= range.maxX; x++) {
+                int cell = (lightRange.slice * this->height + y) * this->width + x;
+                this->indices[this->cells[cell * 2] + this->cells[cell * 2 + 1]++] = lightRange.light;
+            }
+        }
+    }
+}
+
+const std::vector<unsigned int>& LightGrid::getCells() const {
+    return this->cells;
+}
+
+const std::vector<unsigned int>& LightGrid::getIndices() const {
+    return this->indices;
+}
+
+bool LightGrid::calculateRange(const Math::Vec3& center, float radius, float nearDepth, float farDepth,
+        float scaleX, float scaleY, CellRange& range) const {
+    if (std::isinf(radius)) {
+        range = { 0, this->width - 1, 0, this->height - 1 };
+        return true;
+    }
+
+    // Projected coordinate scale * x / depth is monotonic in both x and depth,
+    // the sphere's bounding slab projects within the values at its corners.
+    float minX = std::numeric_limits<float>::max();
+    float maxX = std::numeric_limits<float>::lowest();
+    float minY = std::numeric_limits<float>::max();
+    float maxY = std::numeric_limits<float>::lowest();
+
+    for (float viewDepth: { nearDepth, farDepth }) {
+        for (float offset: { -radius, radius }) {
+            float x = scaleX * (center.get(Math::Vec3::X) + offset) / viewDepth;
+            float y = scaleY * (center.get(Math::Vec3::Y) + offset) / viewDepth;
+
+            minX = std::min(minX, x);
+            maxX = std::max(maxX, x);
+            minY = std::min(minY, y);
+            maxY = std::max(maxY, y);
+        }
+    }
+
+    if (maxX < -1.0f || minX > 1.0f || maxY < -1.0f || minY > 1.0f) {
+        return false;
+    }
+
+    auto findTile = [](float coordinate, int tiles) {
+        int tile = static_cast<int>(floorf((coordinate + 1.0f) / 2.0f * tiles));
+        return std::min(std::max(tile, 0), tiles - 1);
+    };
+
+    range.minX = findTile(minX, this->width);
+    range.maxX = findTile(maxX, this->width);
+    range.minY = findTile(minY, this->height);
+    range.maxY = findTile(maxY, this->height);
+
+    return true;
+}
+
+}  // namespace Graphene
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LIGHTGRID_H
+#define LIGHTGRID_H
+
+#include <GrapheneApi.h>
+#include <NonCopyable.h>
+#include <BoundingVolume.h>
+#include <Camera.h>
+#include <Mat4.h>
+#include <vector>
+#include <memory>
+
+namespace Graphene {
+
+/*
+ * Froxel grid over the camera frustum. Tiles are uniform in screen space, slices are exponential in
+ * view space depth: slice = log(depth) * depthScale + depthBias. Every cell references the lights
+ * whose bounding spheres overlap it, see clustered_lighting.shader.
+ */
+class LightGrid: public NonCopyable {
+public:
+    GRAPHENE_API LightGrid(int width, int height, int depth);
+
+    GRAPHENE_API int getWidth() const;
+    GRAPHENE_API int getHeight() const;
+    GRAPHENE_API int getDepth() const;
+
+    GRAPHENE_API float getDepthScale() const;
+    GRAPHENE_API float getDepthBias() const;
+
+    GRAPHENE_API void update(const std::shared_ptr<Camera>& camera, const Math::Mat4& modelView,
+            const std::vector<BoundingSphere>& lightVolumes);
+
+    GRAPHENE_API const std::vector<unsigned int>& getCells() const;  // Offset and count pairs, X-major
+    GRAPHENE_API const std::vector<unsigned int>& getIndices() const;  // Indices into update() lightVolumes
+
+private:
+    struct CellRange {
+        int minX, maxX;
+        int minY, maxY;
+    };
+
+    bool calculateRange(const Math::Vec3& center, float radius, float nearDepth, float farDepth,
+            float scaleX, float scaleY, CellRange& range) const;
+
+    int width = 0;
+    int height = 0;
+    int depth = 0;
+
+    float depthScale = 0.0f;
+    float depthBias = 0.0f;
+
+    std::vector<unsigned int> cells;
+    std::vector<unsigned int> indices;
+};
+
+}  // namespace Graphene
+
+#endif  // LIGHTGRID_H
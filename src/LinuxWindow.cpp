@@ -24,6 +24,7 @@
 
 #include <LinuxWindow.h>
 #include <EngineConfig.h>
+#include <RenderTargetPool.h>
 #include <Input.h>
 #include <Logger.h>
 #include <RenderTarget.h>
@@ -44,7 +45,11 @@ LinuxWindow::~LinuxWindow() {
     this->setFullscreen(false);
 
     this->overlays.clear();
-    this->geometryBuffers.clear();
+    this->geometryViewports.clear();
+    this->frameGraph.reset();
+    this->gpuTimer.reset();
+    this->contextWorker.reset();  // Joins before the shared context goes
+    GetRenderTargetPool().teardown();  // Pooled targets belong to the context
 
     this->destroyContext();
     this->destroyKeyboardMapping();
@@ -269,7 +274,20 @@ void LinuxWindow::swapBuffers() {
     glXSwapBuffers(this->display, this->window);
 }
 
+void LinuxWindow::makeSharedContextCurrent() {
+    // GL 3.0+ contexts need no drawable, see GLX_ARB_create_context
+    if (!glXMakeContextCurrent(this->display, None, None, this->sharedContext)) {
+        throw std::runtime_error(LogFormat("glXMakeContextCurrent()"));
+    }
+}
+
+void LinuxWindow::releaseSharedContext() {
+    glXMakeContextCurrent(this->display, None, None, nullptr);
+}
+
 void LinuxWindow::createWindow(const char* windowName) {
+    XInitThreads();  // Context worker makes its context current on the same display
+
     this->display = XOpenDisplay(nullptr);
     if (this->display == nullptr) {
         throw std::runtime_error(LogFormat("XOpenDisplay()"));
@@ -417,6 +435,12 @@ void LinuxWindow::createContext() {
         throw std::runtime_error(LogFormat("glXMakeCurrent()"));
     }
 
+    // Shares objects with the rendering context, backs the context worker
+    this->sharedContext = glXCreateContextAttribsARB(this->display, this->fbConfig, this->renderingContext, True, contextAttribList);
+    if (this->sharedContext == nullptr) {
+        throw std::runtime_error(LogFormat("glXCreateContextAttribsARB()"));
+    }
+
     std::stringstream extensions(glXQueryExtensionsString(this->display, this->screen));
     std::string extension;
 
@@ -429,6 +453,11 @@ void LinuxWindow::destroyContext() {
     if (this->display != nullptr) {
         glXMakeCurrent(this->display, None, None);
 
+        if (this->sharedContext != nullptr) {
+            glXDestroyContext(this->display, this->sharedContext);
+            this->sharedContext = nullptr;
+        }
+
         if (this->renderingContext != nullptr) {
             glXDestroyContext(this->display, this->renderingContext);
             this->renderingContext = nullptr;
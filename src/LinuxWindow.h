@@ -44,6 +44,10 @@ public:
     GRAPHENE_API bool dispatchEvents() override;
     GRAPHENE_API void swapBuffers() override;
 
+protected:
+    void makeSharedContextCurrent() override;
+    void releaseSharedContext() override;
+
 private:
     void createWindow(const char* windowName);
     void destroyWindow();
@@ -66,6 +70,7 @@ private:
     Atom wmStateFullscreen = None;
     int xrandrEventBase = 0;
     GLXContext renderingContext = nullptr;
+    GLXContext sharedContext = nullptr;
 
     int firstKeycode = 0;
     int keysymsPerKeycode = 0;
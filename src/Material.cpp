@@ -24,12 +24,14 @@
 #include <Logger.h>
 #include <stdexcept>
 #include <algorithm>
+#include <cassert>
+#include <climits>
 
 namespace Graphene {
 
 #pragma pack(push, 1)
 
-/* std140 layout */
+/* std140 layout, fits MATERIAL_RECORD_SIZE */
 typedef struct {
     float ambientIntensity;
     float diffuseIntensity;
@@ -43,8 +45,20 @@ typedef struct {
 #pragma pack(pop)
 
 Material::Material() {
-    MaterialBuffer material = { };
-    this->materialBuffer = std::make_shared<UniformBuffer>(&material, sizeof(material));
+    static int nextMaterialId = 0;
+    assert(nextMaterialId <= INT_MAX);
+    this->materialId = nextMaterialId++;
+
+    static_assert(sizeof(MaterialBuffer) <= MATERIAL_RECORD_SIZE, "MaterialBuffer exceeds MATERIAL_RECORD_SIZE");
+    this->materialRecord = GetMaterialTable().createRecord();
+}
+
+Material::~Material() {
+    GetMaterialTable().destroyRecord(this->materialRecord);
+}
+
+int Material::getId() const {
+    return this->materialId;
 }
 
 const std::shared_ptr<Texture>& Material::getDiffuseTexture() const {
@@ -140,7 +154,7 @@ void Material::bind(BindPoint bindPoint) {
         this->updateMaterialBuffer();
     }
 
-    this->materialBuffer->bind(bindPoint);
+    GetMaterialTable().bindRecord(this->materialRecord, bindPoint);
 }
 
 void Material::updateMaterialBuffer() {
@@ -155,7 +169,7 @@ void Material::updateMaterialBuffer() {
     material.specularHardness = this->specularHardness;
     material.hasDiffuseTexture = (this->diffuseTexture != nullptr);
 
-    this->materialBuffer->update(&material, sizeof(material));
+    GetMaterialTable().updateRecord(this->materialRecord, &material, sizeof(material));
 }
 
 }  // namespace Graphene
@@ -27,6 +27,7 @@
 #include <NonCopyable.h>
 #include <ImageTexture.h>
 #include <UniformBuffer.h>
+#include <MaterialTable.h>
 #include <Vec3.h>
 #include <memory>
 
@@ -35,6 +36,9 @@ namespace Graphene {
 class Material: public NonCopyable {
 public:
     GRAPHENE_API Material();
+    GRAPHENE_API ~Material();
+
+    GRAPHENE_API int getId() const;
 
     GRAPHENE_API const std::shared_ptr<Texture>& getDiffuseTexture() const;
     GRAPHENE_API void setDiffuseTexture(const std::shared_ptr<Texture>& diffuseTexture);
@@ -64,7 +68,9 @@ public:
 private:
     void updateMaterialBuffer();
 
-    std::shared_ptr<UniformBuffer> materialBuffer;
+    int materialId = 0;
+    int materialRecord = -1;  // MaterialTable record
+
     std::shared_ptr<Texture> diffuseTexture;
 
     float ambientIntensity = 1.0f;
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <MaterialTable.h>
+#include <Logger.h>
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+
+namespace Graphene {
+
+MaterialTable& MaterialTable::getInstance() {
+    static MaterialTable instance;
+    return instance;
+}
+
+int MaterialTable::createRecord() {
+    if (this->recordStride == 0) {
+        GLint offsetAlignment = 0;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &offsetAlignment);
+        offsetAlignment = std::max(offsetAlignment, 1);
+
+        this->recordStride = (MATERIAL_RECORD_SIZE + offsetAlignment - 1) / offsetAlignment * offsetAlignment;
+    }
+
+    if (!this->freeRecords.empty()) {
+        int record = this->freeRecords.back();
+        this->freeRecords.pop_back();
+
+        return record;
+    }
+
+    // Grow geometrically, the buffer is reallocated on the next flush
+    size_t recordsSize = this->recordStride * (this->recordsCount + 1);
+    if (recordsSize > this->records.size()) {
+        this->records.resize(std::max(this->records.size() * 2, this->recordStride * 64), 0);
+        this->bufferResized = true;
+    }
+
+    return this->recordsCount++;
+}
+
+void MaterialTable::destroyRecord(int record) {
+    if (record < 0 || record >= this->getRecordsCount()) {
+        throw std::invalid_argument(LogFormat("Invalid material record %d", record));
+    }
+
+    this->freeRecords.push_back(record);
+}
+
+void MaterialTable::updateRecord(int record, const void* data, size_t dataSize) {
+    if (record < 0 || record >= this->getRecordsCount()) {
+        throw std::invalid_argument(LogFormat("Invalid material record %d", record));
+    }
+
+    if (dataSize > MATERIAL_RECORD_SIZE) {
+        throw std::invalid_argument(LogFormat("Material record size %zu exceeds %d", dataSize, MATERIAL_RECORD_SIZE));
+    }
+
+    size_t recordOffset = this->recordStride * record;
+    std::memcpy(this->records.data() + recordOffset, data, dataSize);
+
+    if (this->dirtyBegin == this->dirtyEnd) {
+        this->dirtyBegin = recordOffset;
+        this->dirtyEnd = recordOffset + dataSize;
+    } else {
+        this->dirtyBegin = std::min(this->dirtyBegin, recordOffset);
+        this->dirtyEnd = std::max(this->dirtyEnd, recordOffset + dataSize);
+    }
+}
+
+void MaterialTable::bindRecord(int record, BindPoint bindPoint) {
+    if (record < 0 || record >= this->getRecordsCount()) {
+        throw std::invalid_argument(LogFormat("Invalid material record %d", record));
+    }
+
+    this->flush();
+    this->recordsBuffer->bind(bindPoint, this->recordStride * record, MATERIAL_RECORD_SIZE);
+}
+
+int MaterialTable::getRecordsCount() const {
+    return this->recordsCount;
+}
+
+void MaterialTable::teardown() {
+    this->recordsBuffer.reset();
+    this->bufferResized = true;  // Recreate if ever used again
+}
+
+void MaterialTable::flush() {
+    if (this->recordsBuffer == nullptr) {
+        this->recordsBuffer = std::make_shared<UniformBuffer>(this->records.data(), this->records.size());
+    } else if (this->bufferResized) {
+        this->recordsBuffer->update(this->records.data(), this->records.size());
+    } else if (this->dirtyBegin != this->dirtyEnd) {
+        this->recordsBuffer->update(this->records.data() + this->dirtyBegin, this->dirtyEnd - this->dirtyBegin, this->dirtyBegin);
+    }
+
+    this->bufferResized = false;
+    this->dirtyBegin = this->dirtyEnd = 0;
+}
+
+}  // namespace Graphene
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MATERIALTABLE_H
+#define MATERIALTABLE_H
+
+#include <GrapheneApi.h>
+#include <NonCopyable.h>
+#include <UniformBuffer.h>
+#include <cstddef>
+#include <vector>
+#include <memory>
+
+#define GetMaterialTable() MaterialTable::getInstance()
+
+#define MATERIAL_RECORD_SIZE 64  // std140 MaterialBuffer rounded up, see Material.cpp
+
+namespace Graphene {
+
+/*
+ * Parameters of all materials packed into a single uniform buffer. Records are spaced by
+ * GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT and selected with a range binding, changes are kept in
+ * a shadow copy and uploaded in one go before the next bind.
+ */
+class MaterialTable: public NonCopyable {
+public:
+    GRAPHENE_API static MaterialTable& getInstance();
+
+    GRAPHENE_API int createRecord();
+    GRAPHENE_API void destroyRecord(int record);
+
+    GRAPHENE_API void updateRecord(int record, const void* data, size_t dataSize);
+    GRAPHENE_API void bindRecord(int record, BindPoint bindPoint);
+
+    GRAPHENE_API int getRecordsCount() const;
+    GRAPHENE_API void teardown();
+
+private:
+    MaterialTable() = default;
+
+    void flush();
+
+    std::shared_ptr<UniformBuffer> recordsBuffer;
+    std::vector<char> records;  // Shadow copy of the buffer
+    std::vector<int> freeRecords;
+    int recordsCount = 0;
+
+    size_t recordStride = 0;
+    size_t dirtyBegin = 0;
+    size_t dirtyEnd = 0;
+    bool bufferResized = false;
+};
+
+}  // namespace Graphene
+
+#endif  // MATERIALTABLE_H
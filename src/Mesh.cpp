@@ -21,15 +21,27 @@
  */
 
 #include <Mesh.h>
+#include <GLStateCache.h>
+#include <Vec3.h>
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cmath>
 
 namespace Graphene {
 
 enum DataBuffer { BUFFER_VERTICES, BUFFER_FACES };
-enum VertexAttribute { ATTRIBUTE_POSITION, ATTRIBUTE_NORMAL, ATTRIBUTE_UV };
+enum VertexAttribute { ATTRIBUTE_POSITION, ATTRIBUTE_NORMAL, ATTRIBUTE_UV, ATTRIBUTE_INSTANCE };
 
-Mesh::Mesh(const void* data, int vertices, int faces):
+#define INSTANCE_COLUMNS 8  // mat4 localWorld, mat4 normalRotation
+
+Mesh::Mesh(const void* data, int vertices, int faces, bool keepGeometry):
         vertices(vertices),
         faces(faces) {
+    static int nextMeshId = 0;
+    assert(nextMeshId <= INT_MAX);
+    this->meshId = nextMeshId++;
+
     const char* meshData = reinterpret_cast<const char*>(data);
 
     const void* vertexData = meshData;
@@ -38,11 +50,13 @@ Mesh::Mesh(const void* data, int vertices, int faces):
     const void* faceData = meshData + vertexDataSize;
     size_t faceDataSize = sizeof(int) * this->faces * 3;
 
+    this->baseInstance = OpenGL::isExtensionSupported("GL_ARB_base_instance");
+
     glGenVertexArrays(1, &this->vao);
-    glBindVertexArray(this->vao);
+    GetGLStateCache().bindVertexArray(this->vao);
 
     glGenBuffers(2, this->buffers);
-    glBindBuffer(GL_ARRAY_BUFFER, this->buffers[BUFFER_VERTICES]);
+    GetGLStateCache().bindBuffer(GL_ARRAY_BUFFER, this->buffers[BUFFER_VERTICES]);
     glBufferData(GL_ARRAY_BUFFER, vertexDataSize, vertexData, GL_STATIC_DRAW);
 
     glEnableVertexAttribArray(ATTRIBUTE_POSITION);
@@ -56,13 +70,44 @@ Mesh::Mesh(const void* data, int vertices, int faces):
     glVertexAttribPointer(ATTRIBUTE_NORMAL, 3, GL_FLOAT, GL_FALSE, 0, reinterpret_cast<const void*>(normalDataOffset));
     glVertexAttribPointer(ATTRIBUTE_UV, 2, GL_FLOAT, GL_FALSE, 0, reinterpret_cast<const void*>(uvDataOffset));
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->buffers[BUFFER_FACES]);
+    GetGLStateCache().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->buffers[BUFFER_FACES]);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, faceDataSize, faceData, GL_STATIC_DRAW);
+
+    const float* positions = reinterpret_cast<const float*>(vertexData);
+    for (int vertex = 0; vertex < this->vertices; vertex++) {
+        this->boundingBox.merge(Math::Vec3(positions[vertex * 3], positions[vertex * 3 + 1], positions[vertex * 3 + 2]));
+    }
+
+    if (!this->boundingBox.isEmpty()) {
+        // Centered at the box, tighter than the sphere around the box corners
+        Math::Vec3 center(this->boundingBox.getCenter());
+        float radius = 0.0f;
+
+        for (int vertex = 0; vertex < this->vertices; vertex++) {
+            Math::Vec3 offset(Math::Vec3(positions[vertex * 3], positions[vertex * 3 + 1], positions[vertex * 3 + 2]) - center);
+            radius = std::max(radius, offset.dot(offset));
+        }
+
+        this->boundingSphere = BoundingSphere(center, sqrtf(radius));
+    }
+
+    if (keepGeometry) {
+        const int* indices = reinterpret_cast<const int*>(faceData);
+        this->positions.assign(positions, positions + this->vertices * 3);
+        this->indices.assign(indices, indices + this->faces * 3);
+        this->meshTree = std::make_shared<MeshTree>(this->positions, this->indices);
+    }
 }
 
 Mesh::~Mesh() {
-    glDeleteVertexArrays(1, &this->vao);
-    glDeleteBuffers(2, this->buffers);
+    auto& stateCache = GetGLStateCache();
+    stateCache.deleteVertexArray(this->vao);
+    stateCache.deleteBuffer(this->buffers[BUFFER_VERTICES]);
+    stateCache.deleteBuffer(this->buffers[BUFFER_FACES]);
+}
+
+int Mesh::getId() const {
+    return this->meshId;
 }
 
 int Mesh::getFaces() const {
@@ -73,9 +118,73 @@ int Mesh::getVertices() const {
     return this->vertices;
 }
 
+const BoundingBox& Mesh::getBoundingBox() const {
+    return this->boundingBox;
+}
+
+const BoundingSphere& Mesh::getBoundingSphere() const {
+    return this->boundingSphere;
+}
+
+bool Mesh::hasGeometry() const {
+    return this->meshTree != nullptr;
+}
+
+const std::vector<float>& Mesh::getPositions() const {
+    return this->positions;
+}
+
+const std::vector<int>& Mesh::getIndices() const {
+    return this->indices;
+}
+
+const std::shared_ptr<MeshTree>& Mesh::getMeshTree() const {
+    return this->meshTree;
+}
+
 void Mesh::render() {
-    glBindVertexArray(this->vao);
+    GetGLStateCache().bindVertexArray(this->vao);
+
     glDrawElements(GL_TRIANGLES, this->faces * 3, GL_UNSIGNED_INT, 0);
 }
 
+void Mesh::renderInstanced(const std::shared_ptr<DynamicBuffer>& instanceBuffer, ptrdiff_t instanceOffset, int instances) {
+    GetGLStateCache().bindVertexArray(this->vao);
+
+    // Per instance attributes are the VAO state, every run lands at a fresh ring offset. With a base
+    // instance they point at the buffer start once and each draw skips to its run, otherwise they
+    // follow the run. Storage is told apart by generation, a grown buffer may reuse the name
+    const ptrdiff_t instanceStride = sizeof(float) * 4 * INSTANCE_COLUMNS;
+    assert(instanceOffset % instanceStride == 0);
+
+    ptrdiff_t attributesOffset = this->baseInstance ? 0 : instanceOffset;
+    uint64_t instanceGeneration = instanceBuffer->getGeneration();
+    if (this->instanceGeneration != instanceGeneration || this->instanceOffset != attributesOffset) {
+        bool attributesEnabled = (this->instanceGeneration != 0);
+        GetGLStateCache().bindBuffer(GL_ARRAY_BUFFER, instanceBuffer->getHandle());
+
+        for (int column = 0; column < INSTANCE_COLUMNS; column++) {
+            GLuint attribute = ATTRIBUTE_INSTANCE + column;
+            ptrdiff_t columnOffset = attributesOffset + sizeof(float) * 4 * column;
+
+            if (!attributesEnabled) {
+                glEnableVertexAttribArray(attribute);
+                glVertexAttribDivisor(attribute, 1);
+            }
+
+            glVertexAttribPointer(attribute, 4, GL_FLOAT, GL_FALSE, instanceStride, reinterpret_cast<const void*>(columnOffset));
+        }
+
+        this->instanceGeneration = instanceGeneration;
+        this->instanceOffset = attributesOffset;
+    }
+
+    if (this->baseInstance) {
+        GLuint firstInstance = static_cast<GLuint>(instanceOffset / instanceStride);
+        glDrawElementsInstancedBaseInstance(GL_TRIANGLES, this->faces * 3, GL_UNSIGNED_INT, 0, instances, firstInstance);
+    } else {
+        glDrawElementsInstanced(GL_TRIANGLES, this->faces * 3, GL_UNSIGNED_INT, 0, instances);
+    }
+}
+
 }  // namespace Graphene
@@ -25,26 +25,56 @@
 
 #include <GrapheneApi.h>
 #include <NonCopyable.h>
+#include <BoundingVolume.h>
+#include <MeshTree.h>
+#include <DynamicBuffer.h>
 #include <OpenGL.h>
+#include <vector>
+#include <memory>
 
 namespace Graphene {
 
 class Mesh: public NonCopyable {
 public:
-    GRAPHENE_API Mesh(const void* data, int vertices, int faces);
+    // Occluders and raycast targets keep a CPU copy of their positions and indices
+    GRAPHENE_API Mesh(const void* data, int vertices, int faces, bool keepGeometry = false);
     GRAPHENE_API ~Mesh();
 
+    GRAPHENE_API int getId() const;
     GRAPHENE_API int getVertices() const;
     GRAPHENE_API int getFaces() const;
 
+    GRAPHENE_API const BoundingBox& getBoundingBox() const;
+    GRAPHENE_API const BoundingSphere& getBoundingSphere() const;
+
+    // Empty unless the geometry was kept, see OcclusionBuffer and Scene::raycast()
+    GRAPHENE_API bool hasGeometry() const;
+    GRAPHENE_API const std::vector<float>& getPositions() const;
+    GRAPHENE_API const std::vector<int>& getIndices() const;
+    GRAPHENE_API const std::shared_ptr<MeshTree>& getMeshTree() const;
+
     GRAPHENE_API void render();
+    GRAPHENE_API void renderInstanced(const std::shared_ptr<DynamicBuffer>& instanceBuffer, ptrdiff_t instanceOffset, int instances);  // See geometry_output.shader
 
 private:
+    int meshId = 0;
+
     GLuint vao = 0;
     GLuint buffers[2] = { };
 
+    uint64_t instanceGeneration = 0;  // Of the instance buffer the attributes point into
+    ptrdiff_t instanceOffset = 0;
+    bool baseInstance = false;  // Attributes stay at the buffer start, draws select their range
+
     int vertices = 0;
     int faces = 0;
+
+    BoundingBox boundingBox;
+    BoundingSphere boundingSphere;
+
+    std::vector<float> positions;  // Positions only
+    std::vector<int> indices;
+    std::shared_ptr<MeshTree> meshTree;
 };
 
 }  // namespace Graphene
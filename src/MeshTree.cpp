@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <MeshTree.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#define TRIANGLE_EPSILON 1e-6f  // Relative to the edges and direction, rays parallel to the triangle plane miss
+
+namespace Graphene {
+
+static bool intersectsBox(const float minimum[3], const float maximum[3], const float origin[3], const float inverseDirection[3], float distance) {
+    float entryDistance = 0.0f;
+    float exitDistance = distance;
+
+    for (int axis = 0; axis < 3; axis++) {
+        float first = (minimum[axis] - origin[axis]) * inverseDirection[axis];
+        float second = (maximum[axis] - origin[axis]) * inverseDirection[axis];
+
+        entryDistance = std::max(entryDistance, std::min(first, second));
+        exitDistance = std::min(exitDistance, std::max(first, second));
+    }
+
+    return entryDistance <= exitDistance;
+}
+
+static bool intersectsTriangle(const float vertices[9], const float origin[3], const float direction[3], float& distance) {
+    // See https://doi.org/10.1080/10867651.1997.10487468 (Moller-Trumbore)
+    float edge1[3], edge2[3], offset[3];
+    for (int axis = 0; axis < 3; axis++) {
+        edge1[axis] = vertices[3 + axis] - vertices[axis];
+        edge2[axis] = vertices[6 + axis] - vertices[axis];
+        offset[axis] = origin[axis] - vertices[axis];
+    }
+
+    float p[3] = {
+        direction[1] * edge2[2] - direction[2] * edge2[1],
+        direction[2] * edge2[0] - direction[0] * edge2[2],
+        direction[0] * edge2[1] - direction[1] * edge2[0]
+    };
+
+    // Determinant scales with the triangle size and the direction length, local space rays are
+    // not normalized and meshes come in any units, so the threshold scales along
+    float determinant = edge1[0] * p[0] + edge1[1] * p[1] + edge1[2] * p[2];
+    float scale = std::sqrt((edge1[0] * edge1[0] + edge1[1] * edge1[1] + edge1[2] * edge1[2]) *
+            (edge2[0] * edge2[0] + edge2[1] * edge2[1] + edge2[2] * edge2[2]) *
+            (direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2]));
+
+    if (std::fabs(determinant) <= TRIANGLE_EPSILON * scale) {
+        return false;
+    }
+
+    float inverseDeterminant = 1.0f / determinant;
+    float u = (offset[0] * p[0] + offset[1] * p[1] + offset[2] * p[2]) * inverseDeterminant;
+    if (u < 0.0f || u > 1.0f) {
+        return false;
+    }
+
+    float q[3] = {
+        offset[1] * edge1[2] - offset[2] * edge1[1],
+        offset[2] * edge1[0] - offset[0] * edge1[2],
+        offset[0] * edge1[1] - offset[1] * edge1[0]
+    };
+
+    float v = (direction[0] * q[0] + direction[1] * q[1] + direction[2] * q[2]) * inverseDeterminant;
+    if (v < 0.0f || u + v > 1.0f) {
+        return false;
+    }
+
+    distance = (edge2[0] * q[0] + edge2[1] * q[1] + edge2[2] * q[2]) * inverseDeterminant;
+    return distance > 0.0f;
+}
+
+MeshTree::MeshTree(const std::vector<float>& positions, const std::vector<int>& indices) {
+    int trianglesCount = static_cast<int>(indices.size()) / 3;
+    std::vector<float> centroids(trianglesCount * 3);
+
+    for (int triangle = 0; triangle < trianglesCount; triangle++) {
+        for (int axis = 0; axis < 3; axis++) {
+            centroids[triangle * 3 + axis] = (positions[indices[triangle * 3] * 3 + axis] +
+                    positions[indices[triangle * 3 + 1] * 3 + axis] + positions[indices[triangle * 3 + 2] * 3 + axis]) / 3.0f;
+        }
+
+        this->triangles.push_back(triangle);
+    }
+
+    this->vertices.resize(trianglesCount * 9);
+    for (int triangle = 0; triangle < trianglesCount; triangle++) {
+        for (int vertex = 0; vertex < 3; vertex++) {
+            const float* position = &positions[indices[triangle * 3 + vertex] * 3];
+            std::copy(position, position + 3, &this->vertices[triangle * 9 + vertex * 3]);
+        }
+    }
+
+    if (trianglesCount > 0) {
+        this->nodes.reserve(trianglesCount * 2);
+        this->build(0, trianglesCount, centroids);
+    }
+
+    // Leaves reference triangle ranges, lay their vertices out in the same order
+    std::vector<float> meshVertices;
+    meshVertices.swap(this->vertices);
+    this->vertices.resize(meshVertices.size());
+
+    for (int triangle = 0; triangle < trianglesCount; triangle++) {
+        const float* source = &meshVertices[this->triangles[triangle] * 9];
+        std::copy(source, source + 9, &this->vertices[triangle * 9]);
+    }
+}
+
+bool MeshTree::raycast(const Math::Vec3& origin, const Math::Vec3& direction, float& distance, int& triangle) const {
+    if (this->nodes.empty()) {
+        return false;
+    }
+
+    const float* rayOrigin = origin.data();
+    const float* rayDirection = direction.data();
+    float inverseDirection[3] = { 1.0f / rayDirection[0], 1.0f / rayDirection[1], 1.0f / rayDirection[2] };
+
+    int stack[MESH_TREE_DEPTH_MAX];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+    bool hit = false;
+
+    while (stackSize > 0) {
+        int index = stack[--stackSize];
+        auto& node = this->nodes[index];
+
+        if (!intersectsBox(node.minimum, node.maximum, rayOrigin, inverseDirection, distance)) {
+            continue;
+        }
+
+        if (node.triangles == 0) {
+            assert(stackSize + 2 <= MESH_TREE_DEPTH_MAX);
+            stack[stackSize++] = node.offset;
+            stack[stackSize++] = index + 1;
+            continue;
+        }
+
+        for (int leafTriangle = node.offset; leafTriangle < node.offset + node.triangles; leafTriangle++) {
+            float triangleDistance = 0.0f;
+            if (intersectsTriangle(&this->vertices[leafTriangle * 9], rayOrigin, rayDirection, triangleDistance) &&
+                    triangleDistance < distance) {
+                distance = triangleDistance;
+                triangle = this->triangles[leafTriangle];
+                hit = true;
+            }
+        }
+    }
+
+    return hit;
+}
+
+int MeshTree::getNodes() const {
+    return static_cast<int>(this->nodes.size());
+}
+
+int MeshTree::getTriangles() const {
+    return static_cast<int>(this->triangles.size());
+}
+
+int MeshTree::build(int first, int count, const std::vector<float>& centroids) {
+    int index = static_cast<int>(this->nodes.size());
+    this->nodes.push_back(Node());
+
+    Node node = { { INFINITY, INFINITY, INFINITY }, { -INFINITY, -INFINITY, -INFINITY }, first, count };
+    float centroidMinimum[3] = { INFINITY, INFINITY, INFINITY };
+    float centroidMaximum[3] = { -INFINITY, -INFINITY, -INFINITY };
+
+    for (int leafTriangle = first; leafTriangle < first + count; leafTriangle++) {
+        int triangle = this->triangles[leafTriangle];
+
+        for (int axis = 0; axis < 3; axis++) {
+            for (int vertex = 0; vertex < 3; vertex++) {
+                float position = this->vertices[triangle * 9 + vertex * 3 + axis];
+                node.minimum[axis] = std::min(node.minimum[axis], position);
+                node.maximum[axis] = std::max(node.maximum[axis], position);
+            }
+
+            centroidMinimum[axis] = std::min(centroidMinimum[axis], centroids[triangle * 3 + axis]);
+            centroidMaximum[axis] = std::max(centroidMaximum[axis], centroids[triangle * 3 + axis]);
+        }
+    }
+
+    int splitAxis = 0;
+    for (int axis = 1; axis < 3; axis++) {
+        if (centroidMaximum[axis] - centroidMinimum[axis] > centroidMaximum[splitAxis] - centroidMinimum[splitAxis]) {
+            splitAxis = axis;
+        }
+    }
+
+    // Coincident centroids cannot be separated, keep them in a larger leaf
+    if (count > MESH_TREE_LEAF_TRIANGLES && centroidMaximum[splitAxis] > centroidMinimum[splitAxis]) {
+        int middle = first + count / 2;
+        std::nth_element(this->triangles.begin() + first, this->triangles.begin() + middle, this->triangles.begin() + first + count,
+                [&centroids, splitAxis](int a, int b) {
+                    return centroids[a * 3 + splitAxis] < centroids[b * 3 + splitAxis];
+                });
+
+        this->build(first, middle - first, centroids);
+        node.offset = this->build(middle, first + count - middle, centroids);
+        node.triangles = 0;
+    }
+
+    this->nodes[index] = node;
+    return index;
+}
+
+}  // namespace Graphene
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MESHTREE_H
+#define MESHTREE_H
+
+#include <GrapheneApi.h>
+#include <NonCopyable.h>
+#include <Vec3.h>
+#include <vector>
+
+#define MESH_TREE_LEAF_TRIANGLES 4
+#define MESH_TREE_DEPTH_MAX      64  // Median splits, far beyond any index count
+
+namespace Graphene {
+
+/*
+ * Bounding volume hierarchy over a mesh's triangles for CPU ray queries. Nodes are split at
+ * the median centroid along their longest axis and stored depth first, a node's left child
+ * directly follows it. Triangle vertices are copied in leaf order so leaves are read linearly.
+ */
+class MeshTree: public NonCopyable {
+public:
+    GRAPHENE_API MeshTree(const std::vector<float>& positions, const std::vector<int>& indices);
+
+    // Nearest hit below the passed distance, both sides of a triangle are hit
+    GRAPHENE_API bool raycast(const Math::Vec3& origin, const Math::Vec3& direction, float& distance, int& triangle) const;
+
+    GRAPHENE_API int getNodes() const;
+    GRAPHENE_API int getTriangles() const;
+
+private:
+    typedef struct {
+        float minimum[3];
+        float maximum[3];
+        int offset;  // First triangle of a leaf, right child of an inner node
+        int triangles;  // Zero for inner nodes
+    } Node;
+
+    int build(int first, int count, const std::vector<float>& centroids);
+
+    std::vector<Node> nodes;
+    std::vector<int> triangles;  // Mesh triangle per leaf triangle
+    std::vector<float> vertices;  // Three vertices per leaf triangle
+};
+
+}  // namespace Graphene
+
+#endif  // MESHTREE_H
@@ -36,6 +36,8 @@ void Movable::translate(const Math::Vec3& position) {
     this->cameraTranslation.set(0, 3, -position.get(Math::Vec3::X));
     this->cameraTranslation.set(1, 3, -position.get(Math::Vec3::Y));
     this->cameraTranslation.set(2, 3, -position.get(Math::Vec3::Z));
+
+    this->invalidateTransformation();
 }
 
 void Movable::move(float x, float y, float z) {
@@ -43,6 +43,9 @@ public:
     GRAPHENE_API const Math::Mat4& getTranslation() const;
     GRAPHENE_API const Math::Mat4& getCameraTranslation() const;
 
+protected:
+    virtual void invalidateTransformation() { }
+
 private:
     Math::Mat4 translation;
     Math::Mat4 cameraTranslation;
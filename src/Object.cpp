@@ -22,6 +22,7 @@
 
 #include <Object.h>
 #include <ObjectGroup.h>
+#include <TransformStore.h>
 #include <Logger.h>
 #include <stdexcept>
 #include <sstream>
@@ -40,6 +41,11 @@ Object::Object(MetaType objectType):
     std::ostringstream defaultName;
     defaultName << std::hex << "Object (0x" << this << ")";
     this->objectName = defaultName.str();
+    this->transformNode = GetTransformStore().createNode();
+}
+
+Object::~Object() {
+    GetTransformStore().destroyNode(this->transformNode);
 }
 
 int Object::getId() const {
@@ -96,4 +102,29 @@ void Object::targetAt(const Math::Vec3& vector) {
     this->rotate(axis, angle);
 }
 
+Math::Mat4 Object::getLocalTransformation() const {
+    return this->getTranslation() * this->getRotation();
+}
+
+Math::Mat4 Object::getWorldTransformation() const {
+    return GetTransformStore().getWorldTransformation(this->transformNode);
+}
+
+Math::Mat4 Object::getWorldRotation() const {
+    return GetTransformStore().getWorldRotation(this->transformNode);
+}
+
+Math::Vec3 Object::getWorldPosition() const {
+    return GetTransformStore().getWorldPosition(this->transformNode);
+}
+
+void Object::invalidateTransformation() {
+    GetTransformStore().setLocalTransformation(this->transformNode, this->getLocalTransformation(), this->getRotation());
+
+    auto parentObject = this->getParent();
+    if (parentObject != nullptr) {
+        parentObject->invalidateBoundingBox();
+    }
+}
+
 }  // namespace Graphene
@@ -28,6 +28,8 @@
 #include <MetaObject.h>
 #include <Rotatable.h>
 #include <Movable.h>
+#include <Mat4.h>
+#include <Vec3.h>
 #include <memory>
 #include <string>
 #include <functional>
@@ -41,7 +43,7 @@ typedef std::function<void(const std::shared_ptr<ObjectGroup>&)> ParentHandler;
 
 class Object: public MetaBase, public Rotatable, public Movable, public NonCopyable {
 public:
-    GRAPHENE_API virtual ~Object() = default;
+    GRAPHENE_API virtual ~Object();
 
     GRAPHENE_API int getId() const;
 
@@ -55,10 +57,18 @@ public:
     GRAPHENE_API void targetAt(float x, float y, float z);
     GRAPHENE_API void targetAt(const Math::Vec3& vector);
 
+    GRAPHENE_API virtual Math::Mat4 getLocalTransformation() const;
+    GRAPHENE_API Math::Mat4 getWorldTransformation() const;
+    GRAPHENE_API Math::Mat4 getWorldRotation() const;
+    GRAPHENE_API Math::Vec3 getWorldPosition() const;
+
 protected:
     Object(MetaType objectType);
 
+    void invalidateTransformation() override;
+
     int objectId = 0;
+    int transformNode = -1;  // Handle into TransformStore
     std::string objectName;
 
     friend class Scene;
@@ -21,6 +21,8 @@
  */
 
 #include <ObjectGroup.h>
+#include <Entity.h>
+#include <TransformStore.h>
 #include <Logger.h>
 #include <stdexcept>
 
@@ -44,7 +46,50 @@ void ObjectGroup::addObject(const std::shared_ptr<Object>& object) {
     }
 
     object->parent = this->toA<ObjectGroup>();
+    GetTransformStore().setParent(object->transformNode, this->transformNode);
+
     this->objects.emplace_back(object);
+    this->invalidateBoundingBox();
+}
+
+Math::Mat4 ObjectGroup::getLocalTransformation() const {
+    return this->getTranslation() * this->getRotation() * this->getScaling();
+}
+
+const BoundingBox& ObjectGroup::getBoundingBox() const {
+    if (this->boundingBoxDirty) {
+        this->boundingBox = BoundingBox();
+
+        for (auto& object: this->objects) {
+            if (object->isA<Entity>()) {
+                this->boundingBox.merge(object->toA<Entity>()->getBoundingBox().transform(object->getLocalTransformation()));
+            } else if (object->isA<ObjectGroup>()) {
+                this->boundingBox.merge(object->toA<ObjectGroup>()->getBoundingBox().transform(object->getLocalTransformation()));
+            }
+        }
+
+        this->boundingBoxDirty = false;
+    }
+
+    return this->boundingBox;
+}
+
+void ObjectGroup::invalidateBoundingBox() {
+    // Ancestors of a dirty group are dirty as well, no need to go further
+    if (this->boundingBoxDirty) {
+        return;
+    }
+
+    this->boundingBoxDirty = true;
+
+    auto parentObject = this->getParent();
+    if (parentObject != nullptr) {
+        parentObject->invalidateBoundingBox();
+    }
+}
+
+void ObjectGroup::invalidateTransformation() {
+    Object::invalidateTransformation();
 }
 
 }  // namespace Graphene
@@ -27,6 +27,8 @@
 #include <Scalable.h>
 #include <MetaObject.h>
 #include <Object.h>
+#include <BoundingVolume.h>
+#include <Mat4.h>
 #include <vector>
 #include <memory>
 
@@ -39,8 +41,19 @@ public:
     GRAPHENE_API const std::vector<std::shared_ptr<Object>>& getObjects() const;
     GRAPHENE_API void addObject(const std::shared_ptr<Object>& object);
 
+    GRAPHENE_API Math::Mat4 getLocalTransformation() const override;
+
+    GRAPHENE_API const BoundingBox& getBoundingBox() const;  // Bounds of the subtree in the group's local space
+    GRAPHENE_API void invalidateBoundingBox();
+
+protected:
+    void invalidateTransformation() override;
+
 private:
     std::vector<std::shared_ptr<Object>> objects;
+
+    mutable BoundingBox boundingBox;  // Updated on access if boundingBoxDirty
+    mutable bool boundingBoxDirty = true;
 };
 
 }  // namespace Graphene
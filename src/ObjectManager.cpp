@@ -31,6 +31,7 @@
 #include <Vec3.h>
 #include <stdexcept>
 #include <utility>
+#include <algorithm>
 #include <sstream>
 #include <cmath>
 #include <cassert>
@@ -162,9 +163,16 @@ ObjectManager& ObjectManager::getInstance() {
     return instance;
 }
 
-const std::shared_ptr<Entity> ObjectManager::createEntity(const std::string& name) {
-    auto entityIt = this->entityCache.find(name);
-    if (entityIt != this->entityCache.end()) {
+const std::shared_ptr<Entity> ObjectManager::createEntity(const std::string& name, bool keepGeometry) {
+    bool cached = (this->entityCache.find(name) != this->entityCache.end());
+    if (cached && keepGeometry) {
+        auto& meshes = this->meshCache.at(name);
+        cached = std::all_of(meshes.begin(), meshes.end(), [](const std::shared_ptr<Mesh>& mesh) {
+            return mesh->hasGeometry();
+        });
+    }
+
+    if (cached) {
         LogDebug("Reuse cached '%s' entity", name.c_str());
     } else {
         LogDebug("Load entity from '%s'", name.c_str());
@@ -186,6 +194,8 @@ const std::shared_ptr<Entity> ObjectManager::createEntity(const std::string& nam
 
         auto& materials = this->materialCache[name];
         auto& meshes = this->meshCache[name];
+        materials.clear();  // Cached without geometry, reloaded with it
+        meshes.clear();
 
         for (int i = 0; i < objectsCount; i++) {
             file.read(reinterpret_cast<char*>(&objectMaterial), sizeof(objectMaterial));
@@ -214,7 +224,7 @@ const std::shared_ptr<Entity> ObjectManager::createEntity(const std::string& nam
             std::unique_ptr<char[]> meshData(new char[meshDataSize]);
             file.read(meshData.get(), meshDataSize);
 
-            auto mesh = std::make_shared<Mesh>(meshData.get(), objectGeometry.vertices, objectGeometry.faces);
+            auto mesh = std::make_shared<Mesh>(meshData.get(), objectGeometry.vertices, objectGeometry.faces, keepGeometry);
             meshes.emplace_back(mesh);
         }
 
@@ -360,12 +370,12 @@ const std::shared_ptr<Entity> ObjectManager::createLabel(int width, int height,
     return label;
 }
 
-const std::shared_ptr<Mesh> ObjectManager::createQuad(FaceWinding winding) {
-    return this->createMesh<QuadMesh>("QuadMesh", winding);
+const std::shared_ptr<Mesh> ObjectManager::createQuad(FaceWinding winding, bool keepGeometry) {
+    return this->createMesh<QuadMesh>("QuadMesh", winding, keepGeometry);
 }
 
-const std::shared_ptr<Mesh> ObjectManager::createCube(FaceWinding winding) {
-    return this->createMesh<CubeMesh>("CubeMesh", winding);
+const std::shared_ptr<Mesh> ObjectManager::createCube(FaceWinding winding, bool keepGeometry) {
+    return this->createMesh<CubeMesh>("CubeMesh", winding, keepGeometry);
 }
 
 const std::shared_ptr<Shader>& ObjectManager::createShader(const std::string& name) {
@@ -497,7 +507,7 @@ void ObjectManager::validateHeader(std::ifstream& file, const std::string& magic
 }
 
 template<typename T>
-const std::shared_ptr<Mesh> ObjectManager::createMesh(const std::string& alias, FaceWinding winding) {
+const std::shared_ptr<Mesh> ObjectManager::createMesh(const std::string& alias, FaceWinding winding, bool keepGeometry) {
     auto meshesIt = this->meshCache.find(alias);
     if (meshesIt == this->meshCache.end()) {
         std::vector<std::shared_ptr<Mesh>> meshes = { nullptr, nullptr };
@@ -505,7 +515,7 @@ const std::shared_ptr<Mesh> ObjectManager::createMesh(const std::string& alias,
     }
 
     auto& mesh = meshesIt->second.at(winding);
-    if (mesh == nullptr) {
+    if (mesh == nullptr || (keepGeometry && !mesh->hasGeometry())) {
         T meshData;
         int vertexElements = sizeof(meshData.vertices) / sizeof(float);
         int vertexIndices = sizeof(meshData.faces) / sizeof(int);
@@ -523,7 +533,7 @@ const std::shared_ptr<Mesh> ObjectManager::createMesh(const std::string& alias,
             }
         }
 
-        mesh = std::make_shared<Mesh>(&meshData, vertexElements / 3, vertexIndices / 3);
+        mesh = std::make_shared<Mesh>(&meshData, vertexElements / 3, vertexIndices / 3, keepGeometry);
     }
 
     return mesh;
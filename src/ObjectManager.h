@@ -52,7 +52,8 @@ class ObjectManager: public NonCopyable {
 public:
     GRAPHENE_API static ObjectManager& getInstance();
 
-    GRAPHENE_API const std::shared_ptr<Entity> createEntity(const std::string& name);
+    // Occluders and raycast targets keep their geometry, see Mesh
+    GRAPHENE_API const std::shared_ptr<Entity> createEntity(const std::string& name, bool keepGeometry = false);
     GRAPHENE_API const std::shared_ptr<Scene> createScene(const std::string& name);
 
     GRAPHENE_API const std::shared_ptr<Camera> createCamera(ProjectionType type) const;
@@ -60,8 +61,8 @@ public:
     GRAPHENE_API const std::shared_ptr<Entity> createSkybox(const std::string& name);
     GRAPHENE_API const std::shared_ptr<Entity> createLabel(int width, int height, const std::string& name, int size);
 
-    GRAPHENE_API const std::shared_ptr<Mesh> createQuad(FaceWinding winding);
-    GRAPHENE_API const std::shared_ptr<Mesh> createCube(FaceWinding winding);
+    GRAPHENE_API const std::shared_ptr<Mesh> createQuad(FaceWinding winding, bool keepGeometry = false);
+    GRAPHENE_API const std::shared_ptr<Mesh> createCube(FaceWinding winding, bool keepGeometry = false);
 
     GRAPHENE_API const std::shared_ptr<Shader>& createShader(const std::string& name);
     GRAPHENE_API const std::shared_ptr<Shader>& createShader();
@@ -77,7 +78,7 @@ private:
     void validateHeader(std::ifstream& file, const std::string& magic);
 
     template<typename T>
-    const std::shared_ptr<Mesh> createMesh(const std::string& alias, FaceWinding winding);
+    const std::shared_ptr<Mesh> createMesh(const std::string& alias, FaceWinding winding, bool keepGeometry);
 
     std::unordered_map<std::string, std::vector<std::shared_ptr<Material>>> materialCache;
     std::unordered_map<std::string, std::vector<std::shared_ptr<Mesh>>> meshCache;
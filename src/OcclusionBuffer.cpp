@@ -0,0 +1,326 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <OcclusionBuffer.h>
+#include <Logger.h>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+#define CLIP_W_EPSILON 0.0001f
+
+namespace Graphene {
+
+OcclusionBuffer::OcclusionBuffer(int width, int height, int workers):
+        width(width),
+        height(height) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument(LogFormat("Occlusion buffer size is not positive"));
+    }
+
+    if (workers < 0) {
+        throw std::invalid_argument(LogFormat("Workers count cannot be negative"));
+    }
+
+    this->depth.assign(this->width * this->height, 1.0f);
+
+    // Band 0 is rasterized by the calling thread
+    for (int band = 1; band <= workers; band++) {
+        this->workers.emplace_back(&OcclusionBuffer::runWorker, this, band);
+    }
+}
+
+OcclusionBuffer::~OcclusionBuffer() {
+    {
+        std::lock_guard<std::mutex> lock(this->workersMutex);
+        this->stopping = true;
+    }
+
+    this->workersStart.notify_all();
+    for (auto& worker: this->workers) {
+        worker.join();
+    }
+}
+
+void OcclusionBuffer::clear(const Math::Mat4& viewProjection) {
+    this->viewProjection = viewProjection;
+    this->occluders.clear();
+    this->triangles.clear();
+
+    std::fill(this->depth.begin(), this->depth.end(), 1.0f);
+}
+
+void OcclusionBuffer::addOccluder(const std::vector<float>& positions, const std::vector<int>& indices, const Math::Mat4& localWorld) {
+    this->occluders.push_back({ &positions, &indices, this->viewProjection * localWorld });
+}
+
+void OcclusionBuffer::rasterize() {
+    this->setupTriangles();
+
+    if (this->workers.empty()) {
+        this->rasterizeBand(0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->workersMutex);
+        this->generation++;
+        this->pendingWorkers = static_cast<int>(this->workers.size());
+    }
+
+    this->workersStart.notify_all();
+    this->rasterizeBand(0);
+
+    std::unique_lock<std::mutex> lock(this->workersMutex);
+    this->workersDone.wait(lock, [this]() {
+        return this->pendingWorkers == 0;
+    });
+}
+
+bool OcclusionBuffer::isVisible(const BoundingBox& boundingBox) const {
+    if (boundingBox.isEmpty()) {
+        return true;
+    }
+
+    const Math::Vec3& minimum = boundingBox.getMinimum();
+    const Math::Vec3& maximum = boundingBox.getMaximum();
+    const float* matrix = this->viewProjection.data();  // Row-major
+
+    float minX = static_cast<float>(this->width);
+    float maxX = 0.0f;
+    float minY = static_cast<float>(this->height);
+    float maxY = 0.0f;
+    float minZ = 1.0f;
+
+    for (int corner = 0; corner < 8; corner++) {
+        float x = (corner & 1) ? maximum.get(Math::Vec3::X) : minimum.get(Math::Vec3::X);
+        float y = (corner & 2) ? maximum.get(Math::Vec3::Y) : minimum.get(Math::Vec3::Y);
+        float z = (corner & 4) ? maximum.get(Math::Vec3::Z) : minimum.get(Math::Vec3::Z);
+
+        float clipX = matrix[0] * x + matrix[1] * y + matrix[2] * z + matrix[3];
+        float clipY = matrix[4] * x + matrix[5] * y + matrix[6] * z + matrix[7];
+        float clipZ = matrix[8] * x + matrix[9] * y + matrix[10] * z + matrix[11];
+        float clipW = matrix[12] * x + matrix[13] * y + matrix[14] * z + matrix[15];
+
+        // Box reaching the camera plane, nothing to compare against
+        if (clipW < CLIP_W_EPSILON || clipZ < -clipW) {
+            return true;
+        }
+
+        minX = std::min(minX, (clipX / clipW * 0.5f + 0.5f) * this->width);
+        maxX = std::max(maxX, (clipX / clipW * 0.5f + 0.5f) * this->width);
+        minY = std::min(minY, (clipY / clipW * 0.5f + 0.5f) * this->height);
+        maxY = std::max(maxY, (clipY / clipW * 0.5f + 0.5f) * this->height);
+        minZ = std::min(minZ, clipZ / clipW);
+    }
+
+    // Every pixel the box touches has to be covered by a nearer occluder
+    int left = std::max(static_cast<int>(std::floor(minX)), 0);
+    int right = std::min(static_cast<int>(std::ceil(maxX)), this->width);
+    int bottom = std::max(static_cast<int>(std::floor(minY)), 0);
+    int top = std::min(static_cast<int>(std::ceil(maxY)), this->height);
+
+    for (int y = bottom; y < top; y++) {
+        const float* row = &this->depth[y * this->width];
+        for (int x = left; x < right; x++) {
+            if (minZ <= row[x]) {
+                return true;
+            }
+        }
+    }
+
+    return left >= right || bottom >= top;  // Off the buffer, left to the frustum test
+}
+
+int OcclusionBuffer::getWidth() const {
+    return this->width;
+}
+
+int OcclusionBuffer::getHeight() const {
+    return this->height;
+}
+
+int OcclusionBuffer::getWorkers() const {
+    return static_cast<int>(this->workers.size());
+}
+
+int OcclusionBuffer::getRasterizedTriangles() const {
+    return static_cast<int>(this->triangles.size());
+}
+
+float OcclusionBuffer::getDepth(int x, int y) const {
+    if (x < 0 || x >= this->width || y < 0 || y >= this->height) {
+        throw std::invalid_argument(LogFormat("Pixel is out of the occlusion buffer"));
+    }
+
+    return this->depth[y * this->width + x];
+}
+
+void OcclusionBuffer::setupTriangles() {
+    for (auto& occluder: this->occluders) {
+        auto& positions = *occluder.positions;
+        auto& indices = *occluder.indices;
+        const float* matrix = occluder.localWorldProjection.data();  // Row-major
+
+        this->clipPositions.resize(positions.size() / 3 * 4);
+        for (size_t vertex = 0; vertex < positions.size() / 3; vertex++) {
+            float x = positions[vertex * 3];
+            float y = positions[vertex * 3 + 1];
+            float z = positions[vertex * 3 + 2];
+
+            for (int row = 0; row < 4; row++) {
+                this->clipPositions[vertex * 4 + row] =
+                        matrix[row * 4] * x + matrix[row * 4 + 1] * y + matrix[row * 4 + 2] * z + matrix[row * 4 + 3];
+            }
+        }
+
+        for (size_t face = 0; face + 2 < indices.size(); face += 3) {
+            Triangle triangle;
+            bool clipped = false;
+
+            for (int corner = 0; corner < 3; corner++) {
+                const float* clip = &this->clipPositions[indices[face + corner] * 4];
+                if (clip[3] < CLIP_W_EPSILON || clip[2] < -clip[3]) {
+                    clipped = true;
+                    break;
+                }
+
+                triangle.x[corner] = (clip[0] / clip[3] * 0.5f + 0.5f) * this->width;
+                triangle.y[corner] = (clip[1] / clip[3] * 0.5f + 0.5f) * this->height;
+                triangle.z[corner] = clip[2] / clip[3];
+            }
+
+            if (clipped) {
+                continue;
+            }
+
+            // Front faces are clockwise, see Engine::setupOpenGL(), flipped to counter clockwise
+            float area = (triangle.x[1] - triangle.x[0]) * (triangle.y[2] - triangle.y[0]) -
+                         (triangle.x[2] - triangle.x[0]) * (triangle.y[1] - triangle.y[0]);
+            if (area >= 0.0f) {
+                continue;
+            }
+
+            std::swap(triangle.x[1], triangle.x[2]);
+            std::swap(triangle.y[1], triangle.y[2]);
+            std::swap(triangle.z[1], triangle.z[2]);
+
+            auto minmaxX = std::minmax({ triangle.x[0], triangle.x[1], triangle.x[2] });
+            auto minmaxY = std::minmax({ triangle.y[0], triangle.y[1], triangle.y[2] });
+            triangle.minX = std::max(static_cast<int>(std::floor(minmaxX.first)), 0);
+            triangle.maxX = std::min(static_cast<int>(std::ceil(minmaxX.second)), this->width);
+            triangle.minY = std::max(static_cast<int>(std::floor(minmaxY.first)), 0);
+            triangle.maxY = std::min(static_cast<int>(std::ceil(minmaxY.second)), this->height);
+
+            if (triangle.minX < triangle.maxX && triangle.minY < triangle.maxY) {
+                this->triangles.push_back(triangle);
+            }
+        }
+    }
+
+    this->occluders.clear();
+}
+
+void OcclusionBuffer::rasterizeBand(int band) {
+    int bands = static_cast<int>(this->workers.size()) + 1;
+    int bandBegin = this->height * band / bands;
+    int bandEnd = this->height * (band + 1) / bands;
+
+    for (auto& triangle: this->triangles) {
+        int rowBegin = std::max(triangle.minY, bandBegin);
+        int rowEnd = std::min(triangle.maxY, bandEnd);
+        if (rowBegin >= rowEnd) {
+            continue;
+        }
+
+        // Edge functions e = a * x + b * y + c, edge i faces vertex i, positive inside
+        float a[3], b[3], c[3];
+        for (int edge = 0; edge < 3; edge++) {
+            int from = (edge + 1) % 3;
+            int to = (edge + 2) % 3;
+
+            a[edge] = triangle.y[from] - triangle.y[to];
+            b[edge] = triangle.x[to] - triangle.x[from];
+            c[edge] = triangle.x[from] * triangle.y[to] - triangle.x[to] * triangle.y[from];
+        }
+
+        // Depth plane from the barycentric weights
+        float area = c[0] + c[1] + c[2];
+        float depthA = (a[0] * triangle.z[0] + a[1] * triangle.z[1] + a[2] * triangle.z[2]) / area;
+        float depthB = (b[0] * triangle.z[0] + b[1] * triangle.z[1] + b[2] * triangle.z[2]) / area;
+        float depthC = (c[0] * triangle.z[0] + c[1] * triangle.z[1] + c[2] * triangle.z[2]) / area;
+
+        // Conservative: edges shrunk by half a pixel so only fully covered pixels pass, and
+        // the farthest depth over the pixel square instead of the depth at its center
+        float shrink[3];
+        for (int edge = 0; edge < 3; edge++) {
+            shrink[edge] = 0.5f * (std::fabs(a[edge]) + std::fabs(b[edge]));
+        }
+        float farthest = 0.5f * (std::fabs(depthA) + std::fabs(depthB));
+
+        for (int y = rowBegin; y < rowEnd; y++) {
+            float centerY = y + 0.5f;
+            float edge0 = b[0] * centerY + c[0] - shrink[0];
+            float edge1 = b[1] * centerY + c[1] - shrink[1];
+            float edge2 = b[2] * centerY + c[2] - shrink[2];
+            float rowDepth = depthB * centerY + depthC + farthest;
+            float* row = &this->depth[y * this->width];
+
+            // Branchless, vectorized by the compiler
+            for (int x = triangle.minX; x < triangle.maxX; x++) {
+                float centerX = x + 0.5f;
+                float pixelDepth = depthA * centerX + rowDepth;
+                bool covered = (a[0] * centerX + edge0 >= 0.0f) & (a[1] * centerX + edge1 >= 0.0f) &
+                               (a[2] * centerX + edge2 >= 0.0f) & (pixelDepth < row[x]);
+                row[x] = covered ? pixelDepth : row[x];
+            }
+        }
+    }
+}
+
+void OcclusionBuffer::runWorker(int band) {
+    int seenGeneration = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(this->workersMutex);
+            this->workersStart.wait(lock, [this, seenGeneration]() {
+                return this->stopping || this->generation != seenGeneration;
+            });
+
+            if (this->stopping) {
+                return;
+            }
+
+            seenGeneration = this->generation;
+        }
+
+        this->rasterizeBand(band);
+
+        std::lock_guard<std::mutex> lock(this->workersMutex);
+        if (--this->pendingWorkers == 0) {
+            this->workersDone.notify_one();
+        }
+    }
+}
+
+}  // namespace Graphene
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef OCCLUSIONBUFFER_H
+#define OCCLUSIONBUFFER_H
+
+#include <GrapheneApi.h>
+#include <NonCopyable.h>
+#include <BoundingVolume.h>
+#include <Mat4.h>
+#include <condition_variable>
+#include <thread>
+#include <mutex>
+#include <vector>
+
+#define OCCLUSION_BUFFER_WIDTH  256
+#define OCCLUSION_BUFFER_HEIGHT 128
+#define OCCLUSION_WORKERS_MAX   3  // Besides the calling thread
+
+namespace Graphene {
+
+/*
+ * Low resolution CPU depth buffer of the occluders nearest depth. Occluder triangles are
+ * transformed on the calling thread and rasterized in horizontal bands, one per worker, no
+ * band is shared so no locking is needed while rasterizing. Triangles crossing the near
+ * plane and back faces are skipped. Occluders only write pixels they fully cover, at their
+ * farthest depth over the pixel, so edges shared by two triangles leave a gap rather than
+ * occluding too much. A box is occluded when its nearest corner lies behind the buffer
+ * over every pixel its screen rectangle touches. Rows are plain float arrays the compiler vectorizes, no GL involved.
+ */
+class OcclusionBuffer: public NonCopyable {
+public:
+    GRAPHENE_API OcclusionBuffer(int width, int height, int workers);
+    GRAPHENE_API ~OcclusionBuffer();
+
+    GRAPHENE_API void clear(const Math::Mat4& viewProjection);
+
+    // Referenced until rasterize(), triangles wound clockwise as seen from the front
+    GRAPHENE_API void addOccluder(const std::vector<float>& positions, const std::vector<int>& indices, const Math::Mat4& localWorld);
+    GRAPHENE_API void rasterize();
+
+    GRAPHENE_API bool isVisible(const BoundingBox& boundingBox) const;  // World space box
+
+    GRAPHENE_API int getWidth() const;
+    GRAPHENE_API int getHeight() const;
+    GRAPHENE_API int getWorkers() const;
+    GRAPHENE_API int getRasterizedTriangles() const;
+
+    GRAPHENE_API float getDepth(int x, int y) const;  // NDC depth, cleared to 1
+
+private:
+    typedef struct {
+        const std::vector<float>* positions;
+        const std::vector<int>* indices;
+        Math::Mat4 localWorldProjection;
+    } Occluder;
+
+    typedef struct {
+        float x[3];  // Buffer pixels
+        float y[3];
+        float z[3];  // NDC
+        int minX;
+        int maxX;
+        int minY;
+        int maxY;
+    } Triangle;
+
+    void setupTriangles();
+    void rasterizeBand(int band);
+    void runWorker(int band);
+
+    int width;
+    int height;
+    Math::Mat4 viewProjection;
+
+    std::vector<Occluder> occluders;
+    std::vector<float> clipPositions;  // Scratch, the occluder being set up
+    std::vector<Triangle> triangles;
+    std::vector<float> depth;
+
+    std::vector<std::thread> workers;
+    std::mutex workersMutex;
+    std::condition_variable workersStart;
+    std::condition_variable workersDone;
+    int generation = 0;
+    int pendingWorkers = 0;
+    bool stopping = false;
+};
+
+}  // namespace Graphene
+
+#endif  // OCCLUSIONBUFFER_H
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <OcclusionQueries.h>
+#include <Mat4.h>
+
+#define OCCLUSION_QUERY_SCALE 1.01f  // Box faces lying on the mesh surface would fight its depth
+
+namespace Graphene {
+
+OcclusionQueries::OcclusionQueries() {
+    struct {
+        float positions[8 * 3];
+        float normals[8 * 3];
+        float uvs[8 * 2];
+        int faces[12 * 3];
+    } boxData = { };
+
+    for (int vertex = 0; vertex < 8; vertex++) {
+        boxData.positions[vertex * 3] = (vertex & 1) ? 0.5f : -0.5f;
+        boxData.positions[vertex * 3 + 1] = (vertex & 2) ? 0.5f : -0.5f;
+        boxData.positions[vertex * 3 + 2] = (vertex & 4) ? 0.5f : -0.5f;
+    }
+
+    // Culling is off while querying, the winding does not matter
+    static const int quads[6][4] = { { 0, 2, 6, 4 }, { 1, 3, 7, 5 }, { 0, 1, 5, 4 }, { 2, 3, 7, 6 }, { 0, 1, 3, 2 }, { 4, 5, 7, 6 } };
+    for (int quad = 0; quad < 6; quad++) {
+        int* faces = boxData.faces + quad * 6;
+        faces[0] = quads[quad][0];
+        faces[1] = quads[quad][1];
+        faces[2] = quads[quad][2];
+        faces[3] = quads[quad][0];
+        faces[4] = quads[quad][2];
+        faces[5] = quads[quad][3];
+    }
+
+    this->box = std::make_shared<Mesh>(&boxData, 8, 12);
+}
+
+OcclusionQueries::~OcclusionQueries() {
+    for (auto& entityQuery: this->entityQueries) {
+        if (entityQuery.second.query != 0) {
+            glDeleteQueries(1, &entityQuery.second.query);
+        }
+    }
+}
+
+void OcclusionQueries::begin(const Math::Vec3& viewPosition, float nearPlane) {
+    this->viewPosition = viewPosition;
+    this->nearPlane = nearPlane;
+
+    this->boxQueue.clear();
+    this->boxQueries.clear();
+}
+
+bool OcclusionQueries::isVisible(int entityId, const BoundingBox& boundingBox) {
+    auto& entityQuery = this->entityQueries.emplace(entityId, EntityQuery{ 0, false, true, false }).first->second;
+    entityQuery.used = true;
+
+    if (entityQuery.pending) {
+        GLint available = GL_FALSE;
+        glGetQueryObjectiv(entityQuery.query, GL_QUERY_RESULT_AVAILABLE, &available);
+
+        if (available != GL_FALSE) {
+            GLint samplesPassed = GL_FALSE;
+            glGetQueryObjectiv(entityQuery.query, GL_QUERY_RESULT, &samplesPassed);
+
+            entityQuery.visible = (samplesPassed != GL_FALSE);
+            entityQuery.pending = false;
+        }
+    }
+
+    if (boundingBox.isEmpty()) {
+        entityQuery.visible = true;
+        return true;
+    }
+
+    // Near plane clips the faces around a viewer inside the box, such a box hides nothing
+    const float* minimum = boundingBox.getMinimum().data();
+    const float* maximum = boundingBox.getMaximum().data();
+    const float* position = this->viewPosition.data();
+    bool inside = true;
+
+    for (int axis = 0; axis < 3; axis++) {
+        inside = inside && position[axis] > minimum[axis] - this->nearPlane && position[axis] < maximum[axis] + this->nearPlane;
+    }
+
+    if (inside) {
+        entityQuery.visible = true;
+        return true;
+    }
+
+    // Query objects are reused only once their result has been read
+    if (!entityQuery.pending) {
+        if (entityQuery.query == 0) {
+            glGenQueries(1, &entityQuery.query);
+        }
+
+        Math::Vec3 center(boundingBox.getCenter());
+        Math::Vec3 extents(boundingBox.getExtents());
+        Math::Mat4 boxTransformation;
+
+        for (int axis = 0; axis < 3; axis++) {
+            boxTransformation.set(axis, axis, extents.data()[axis] * 2.0f * OCCLUSION_QUERY_SCALE);
+            boxTransformation.set(axis, 3, center.data()[axis]);
+        }
+
+        int transformation = this->boxQueue.addTransformation(boxTransformation, Math::Mat4());
+        this->boxQueue.addItem(0, nullptr, this->box.get(), transformation);
+        this->boxQueries.push_back(entityQuery.query);
+
+        entityQuery.pending = true;
+    }
+
+    return entityQuery.visible;
+}
+
+void OcclusionQueries::submit(const std::shared_ptr<DynamicBuffer>& instanceBuffer) {
+    auto& boxQueries = this->boxQueries;
+
+    this->boxQueue.submitEach(instanceBuffer, [&boxQueries](size_t item) {
+        glBeginQuery(GL_ANY_SAMPLES_PASSED, boxQueries[item]);
+    }, [](size_t /*item*/) {
+        glEndQuery(GL_ANY_SAMPLES_PASSED);
+    });
+
+    for (auto entityQuery = this->entityQueries.begin(); entityQuery != this->entityQueries.end(); ) {
+        if (entityQuery->second.used) {
+            entityQuery->second.used = false;
+            entityQuery++;
+            continue;
+        }
+
+        if (entityQuery->second.query != 0) {
+            glDeleteQueries(1, &entityQuery->second.query);
+        }
+
+        entityQuery = this->entityQueries.erase(entityQuery);
+    }
+
+    this->boxQueue.clear();
+    this->boxQueries.clear();
+}
+
+}  // namespace Graphene
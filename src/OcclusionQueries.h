@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef OCCLUSIONQUERIES_H
+#define OCCLUSIONQUERIES_H
+
+#include <GrapheneApi.h>
+#include <NonCopyable.h>
+#include <BoundingVolume.h>
+#include <DynamicBuffer.h>
+#include <RenderQueue.h>
+#include <OpenGL.h>
+#include <Mesh.h>
+#include <Vec3.h>
+#include <unordered_map>
+#include <memory>
+#include <vector>
+
+#define OCCLUSION_QUERY_FACES_MIN 4096  // Lighter entities draw about as cheap as their box
+
+namespace Graphene {
+
+/*
+ * GL_ANY_SAMPLES_PASSED queries of world bounding boxes drawn against the depth of the frame
+ * just rendered. Results are read without waiting and decide the following frame, an entity
+ * stays drawn until its query says otherwise. Hidden entities keep being queried so they
+ * come back a frame after their box does. Results depend on the view, one set per camera.
+ */
+class OcclusionQueries: public NonCopyable {
+public:
+    GRAPHENE_API OcclusionQueries();
+    GRAPHENE_API ~OcclusionQueries();
+
+    GRAPHENE_API void begin(const Math::Vec3& viewPosition, float nearPlane);
+    GRAPHENE_API bool isVisible(int entityId, const BoundingBox& boundingBox);  // World space box, queued for submit()
+    GRAPHENE_API void submit(const std::shared_ptr<DynamicBuffer>& instanceBuffer);  // Expects a depth only program, no writes
+
+private:
+    typedef struct {
+        GLuint query;
+        bool pending;
+        bool visible;
+        bool used;  // Since the last submit(), queries of entities gone from view are released
+    } EntityQuery;
+
+    std::shared_ptr<Mesh> box;  // Unit cube centered at the origin
+    RenderQueue boxQueue;
+    std::vector<GLuint> boxQueries;  // In boxQueue order
+    std::unordered_map<int, EntityQuery> entityQueries;
+
+    Math::Vec3 viewPosition;
+    float nearPlane = 0.0f;
+};
+
+}  // namespace Graphene
+
+#endif  // OCCLUSIONQUERIES_H
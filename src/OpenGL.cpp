@@ -28,16 +28,21 @@ namespace Graphene {
 
 PFNGLACTIVETEXTUREPROC glActiveTexture;
 PFNGLATTACHSHADERPROC glAttachShader;
+PFNGLBEGINQUERYPROC glBeginQuery;
 PFNGLBINDBUFFERPROC glBindBuffer;
 PFNGLBINDBUFFERBASEPROC glBindBufferBase;
+PFNGLBINDBUFFERRANGEPROC glBindBufferRange;
 PFNGLBINDFRAMEBUFFERPROC glBindFramebuffer;
 PFNGLBINDTEXTUREPROC glBindTexture;
 PFNGLBINDVERTEXARRAYPROC glBindVertexArray;
 PFNGLBLENDCOLORPROC glClearColor;
+PFNGLBLITFRAMEBUFFERPROC glBlitFramebuffer;
 PFNGLBLENDFUNCPROC glBlendFunc;
 PFNGLBUFFERDATAPROC glBufferData;
 PFNGLBUFFERSUBDATAPROC glBufferSubData;
 PFNGLCLEARPROC glClear;
+PFNGLCLIENTWAITSYNCPROC glClientWaitSync;
+PFNGLCOLORMASKPROC glColorMask;
 PFNGLCOMPILESHADERPROC glCompileShader;
 PFNGLCREATEPROGRAMPROC glCreateProgram;
 PFNGLCREATESHADERPROC glCreateShader;
@@ -45,21 +50,29 @@ PFNGLCULLFACEPROC glCullFace;
 PFNGLDELETEBUFFERSPROC glDeleteBuffers;
 PFNGLDELETEFRAMEBUFFERSPROC glDeleteFramebuffers;
 PFNGLDELETEPROGRAMPROC glDeleteProgram;
+PFNGLDELETEQUERIESPROC glDeleteQueries;
 PFNGLDELETESHADERPROC glDeleteShader;
+PFNGLDELETESYNCPROC glDeleteSync;
 PFNGLDELETETEXTURESPROC glDeleteTextures;
 PFNGLDELETEVERTEXARRAYSPROC glDeleteVertexArrays;
 PFNGLDEPTHFUNCPROC glDepthFunc;
+PFNGLDEPTHMASKPROC glDepthMask;
 PFNGLDISABLEPROC glDisable;
 PFNGLDRAWBUFFERPROC glDrawBuffer;
 PFNGLDRAWBUFFERSPROC glDrawBuffers;
 PFNGLDRAWELEMENTSPROC glDrawElements;
+PFNGLDRAWELEMENTSINSTANCEDPROC glDrawElementsInstanced;
 PFNGLENABLEPROC glEnable;
+PFNGLENDQUERYPROC glEndQuery;
 PFNGLENABLEVERTEXATTRIBARRAYPROC glEnableVertexAttribArray;
+PFNGLFENCESYNCPROC glFenceSync;
+PFNGLFLUSHPROC glFlush;
 PFNGLFRAMEBUFFERTEXTUREPROC glFramebufferTexture;
 PFNGLFRONTFACEPROC glFrontFace;
 PFNGLGENBUFFERSPROC glGenBuffers;
 PFNGLGENERATEMIPMAPPROC glGenerateMipmap;
 PFNGLGENFRAMEBUFFERSPROC glGenFramebuffers;
+PFNGLGENQUERIESPROC glGenQueries;
 PFNGLGENTEXTURESPROC glGenTextures;
 PFNGLGENVERTEXARRAYSPROC glGenVertexArrays;
 PFNGLGETACTIVEUNIFORMNAMEPROC glGetActiveUniformName;
@@ -68,7 +81,10 @@ PFNGLGETERRORPROC glGetError;
 PFNGLGETINTEGERVPROC glGetIntegerv;
 PFNGLGETPROGRAMINFOLOGPROC glGetProgramInfoLog;
 PFNGLGETPROGRAMIVPROC glGetProgramiv;
+PFNGLGETQUERYOBJECTIVPROC glGetQueryObjectiv;
+PFNGLGETQUERYOBJECTUI64VPROC glGetQueryObjectui64v;
 PFNGLREADPIXELSPROC glReadPixels;
+PFNGLSCISSORPROC glScissor;
 PFNGLGETSHADERINFOLOGPROC glGetShaderInfoLog;
 PFNGLGETSHADERIVPROC glGetShaderiv;
 PFNGLGETSTRINGPROC glGetString;
@@ -77,7 +93,9 @@ PFNGLGETUNIFORMBLOCKINDEXPROC glGetUniformBlockIndex;
 PFNGLGETUNIFORMLOCATIONPROC glGetUniformLocation;
 PFNGLLINEWIDTHPROC glLineWidth;
 PFNGLLINKPROGRAMPROC glLinkProgram;
+PFNGLMAPBUFFERRANGEPROC glMapBufferRange;
 PFNGLSHADERSOURCEPROC glShaderSource;
+PFNGLTEXBUFFERPROC glTexBuffer;
 PFNGLTEXPARAMETERIPROC glTexParameteri;
 PFNGLTEXSTORAGE2DPROC glTexStorage2D;
 PFNGLTEXSUBIMAGE2DPROC glTexSubImage2D;
@@ -88,12 +106,20 @@ PFNGLUNIFORM4FVPROC glUniform4fv;
 PFNGLUNIFORMBLOCKBINDINGPROC glUniformBlockBinding;
 PFNGLUNIFORMMATRIX3FVPROC glUniformMatrix3fv;
 PFNGLUNIFORMMATRIX4FVPROC glUniformMatrix4fv;
+PFNGLUNMAPBUFFERPROC glUnmapBuffer;
 PFNGLUSEPROGRAMPROC glUseProgram;
+PFNGLVERTEXATTRIBDIVISORPROC glVertexAttribDivisor;
 PFNGLVERTEXATTRIBPOINTERPROC glVertexAttribPointer;
 PFNGLVIEWPORTPROC glViewport;
 
 PFNGLDEBUGMESSAGECALLBACKARBPROC glDebugMessageCallbackARB;
 PFNGLDEBUGMESSAGECONTROLARBPROC glDebugMessageControlARB;
+PFNGLBUFFERSTORAGEPROC glBufferStorage;
+PFNGLDRAWELEMENTSINSTANCEDBASEINSTANCEPROC glDrawElementsInstancedBaseInstance;
+PFNGLGETPROGRAMBINARYPROC glGetProgramBinary;
+PFNGLMAXSHADERCOMPILERTHREADSKHRPROC glMaxShaderCompilerThreadsKHR;
+PFNGLPROGRAMBINARYPROC glProgramBinary;
+PFNGLPROGRAMPARAMETERIPROC glProgramParameteri;
 
 #if defined(_WIN32)
 PFNWGLCHOOSEPIXELFORMATARBPROC wglChoosePixelFormatARB;
@@ -141,16 +167,21 @@ namespace OpenGL {
 void loadCore() {
     LOAD_MANDATORY(glActiveTexture);
     LOAD_MANDATORY(glAttachShader);
+    LOAD_MANDATORY(glBeginQuery);
     LOAD_MANDATORY(glBindBuffer);
     LOAD_MANDATORY(glBindBufferBase);
+    LOAD_MANDATORY(glBindBufferRange);
     LOAD_MANDATORY(glBindFramebuffer);
     LOAD_MANDATORY(glBindTexture);
     LOAD_MANDATORY(glBindVertexArray);
     LOAD_MANDATORY(glClearColor);
+    LOAD_MANDATORY(glBlitFramebuffer);
     LOAD_MANDATORY(glBlendFunc);
     LOAD_MANDATORY(glBufferData);
     LOAD_MANDATORY(glBufferSubData);
     LOAD_MANDATORY(glClear);
+    LOAD_MANDATORY(glClientWaitSync);
+    LOAD_MANDATORY(glColorMask);
     LOAD_MANDATORY(glCompileShader);
     LOAD_MANDATORY(glCreateProgram);
     LOAD_MANDATORY(glCreateShader);
@@ -158,21 +189,29 @@ void loadCore() {
     LOAD_MANDATORY(glDeleteBuffers);
     LOAD_MANDATORY(glDeleteFramebuffers);
     LOAD_MANDATORY(glDeleteProgram);
+    LOAD_MANDATORY(glDeleteQueries);
     LOAD_MANDATORY(glDeleteShader);
+    LOAD_MANDATORY(glDeleteSync);
     LOAD_MANDATORY(glDeleteTextures);
     LOAD_MANDATORY(glDeleteVertexArrays);
     LOAD_MANDATORY(glDepthFunc);
+    LOAD_MANDATORY(glDepthMask);
     LOAD_MANDATORY(glDisable);
     LOAD_MANDATORY(glDrawBuffer);
     LOAD_MANDATORY(glDrawBuffers);
     LOAD_MANDATORY(glDrawElements);
+    LOAD_MANDATORY(glDrawElementsInstanced);
     LOAD_MANDATORY(glEnable);
+    LOAD_MANDATORY(glEndQuery);
     LOAD_MANDATORY(glEnableVertexAttribArray);
+    LOAD_MANDATORY(glFenceSync);
+    LOAD_MANDATORY(glFlush);
     LOAD_MANDATORY(glFramebufferTexture);
     LOAD_MANDATORY(glFrontFace);
     LOAD_MANDATORY(glGenBuffers);
     LOAD_MANDATORY(glGenerateMipmap);
     LOAD_MANDATORY(glGenFramebuffers);
+    LOAD_MANDATORY(glGenQueries);
     LOAD_MANDATORY(glGenTextures);
     LOAD_MANDATORY(glGenVertexArrays);
     LOAD_MANDATORY(glGetActiveUniformName);
@@ -181,7 +220,10 @@ void loadCore() {
     LOAD_MANDATORY(glGetIntegerv);
     LOAD_MANDATORY(glGetProgramInfoLog);
     LOAD_MANDATORY(glGetProgramiv);
+    LOAD_MANDATORY(glGetQueryObjectiv);
+    LOAD_MANDATORY(glGetQueryObjectui64v);
     LOAD_MANDATORY(glReadPixels);
+    LOAD_MANDATORY(glScissor);
     LOAD_MANDATORY(glGetShaderInfoLog);
     LOAD_MANDATORY(glGetShaderiv);
     LOAD_MANDATORY(glGetString);
@@ -190,7 +232,9 @@ void loadCore() {
     LOAD_MANDATORY(glGetUniformLocation);
     LOAD_MANDATORY(glLineWidth);
     LOAD_MANDATORY(glLinkProgram);
+    LOAD_MANDATORY(glMapBufferRange);
     LOAD_MANDATORY(glShaderSource);
+    LOAD_MANDATORY(glTexBuffer);
     LOAD_MANDATORY(glTexParameteri);
     LOAD_MANDATORY(glTexStorage2D);
     LOAD_MANDATORY(glTexSubImage2D);
@@ -201,7 +245,9 @@ void loadCore() {
     LOAD_MANDATORY(glUniformBlockBinding);
     LOAD_MANDATORY(glUniformMatrix3fv);
     LOAD_MANDATORY(glUniformMatrix4fv);
+    LOAD_MANDATORY(glUnmapBuffer);
     LOAD_MANDATORY(glUseProgram);
+    LOAD_MANDATORY(glVertexAttribDivisor);
     LOAD_MANDATORY(glVertexAttribPointer);
     LOAD_MANDATORY(glViewport);
 }
@@ -218,6 +264,12 @@ void loadExtensions() {
 
     LOAD_OPTIONAL(glDebugMessageControlARB);
     LOAD_OPTIONAL(glDebugMessageCallbackARB);
+    LOAD_OPTIONAL(glBufferStorage);
+    LOAD_OPTIONAL(glDrawElementsInstancedBaseInstance);
+    LOAD_OPTIONAL(glGetProgramBinary);
+    LOAD_OPTIONAL(glMaxShaderCompilerThreadsKHR);
+    LOAD_OPTIONAL(glProgramBinary);
+    LOAD_OPTIONAL(glProgramParameteri);
 }
 
 #if defined(_WIN32)
@@ -42,16 +42,21 @@ namespace Graphene {
 
 extern GRAPHENE_API PFNGLACTIVETEXTUREPROC glActiveTexture;
 extern GRAPHENE_API PFNGLATTACHSHADERPROC glAttachShader;
+extern GRAPHENE_API PFNGLBEGINQUERYPROC glBeginQuery;
 extern GRAPHENE_API PFNGLBINDBUFFERPROC glBindBuffer;
 extern GRAPHENE_API PFNGLBINDBUFFERBASEPROC glBindBufferBase;
+extern GRAPHENE_API PFNGLBINDBUFFERRANGEPROC glBindBufferRange;
 extern GRAPHENE_API PFNGLBINDFRAMEBUFFERPROC glBindFramebuffer;
 extern GRAPHENE_API PFNGLBINDTEXTUREPROC glBindTexture;
 extern GRAPHENE_API PFNGLBINDVERTEXARRAYPROC glBindVertexArray;
 extern GRAPHENE_API PFNGLBLENDCOLORPROC glClearColor;
+extern GRAPHENE_API PFNGLBLITFRAMEBUFFERPROC glBlitFramebuffer;
 extern GRAPHENE_API PFNGLBLENDFUNCPROC glBlendFunc;
 extern GRAPHENE_API PFNGLBUFFERDATAPROC glBufferData;
 extern GRAPHENE_API PFNGLBUFFERSUBDATAPROC glBufferSubData;
 extern GRAPHENE_API PFNGLCLEARPROC glClear;
+extern GRAPHENE_API PFNGLCLIENTWAITSYNCPROC glClientWaitSync;
+extern GRAPHENE_API PFNGLCOLORMASKPROC glColorMask;
 extern GRAPHENE_API PFNGLCOMPILESHADERPROC glCompileShader;
 extern GRAPHENE_API PFNGLCREATEPROGRAMPROC glCreateProgram;
 extern GRAPHENE_API PFNGLCREATESHADERPROC glCreateShader;
@@ -59,21 +64,29 @@ extern GRAPHENE_API PFNGLCULLFACEPROC glCullFace;
 extern GRAPHENE_API PFNGLDELETEBUFFERSPROC glDeleteBuffers;
 extern GRAPHENE_API PFNGLDELETEFRAMEBUFFERSPROC glDeleteFramebuffers;
 extern GRAPHENE_API PFNGLDELETEPROGRAMPROC glDeleteProgram;
+extern GRAPHENE_API PFNGLDELETEQUERIESPROC glDeleteQueries;
 extern GRAPHENE_API PFNGLDELETESHADERPROC glDeleteShader;
+extern GRAPHENE_API PFNGLDELETESYNCPROC glDeleteSync;
 extern GRAPHENE_API PFNGLDELETETEXTURESPROC glDeleteTextures;
 extern GRAPHENE_API PFNGLDELETEVERTEXARRAYSPROC glDeleteVertexArrays;
 extern GRAPHENE_API PFNGLDEPTHFUNCPROC glDepthFunc;
+extern GRAPHENE_API PFNGLDEPTHMASKPROC glDepthMask;
 extern GRAPHENE_API PFNGLDISABLEPROC glDisable;
 extern GRAPHENE_API PFNGLDRAWBUFFERPROC glDrawBuffer;
 extern GRAPHENE_API PFNGLDRAWBUFFERSPROC glDrawBuffers;
 extern GRAPHENE_API PFNGLDRAWELEMENTSPROC glDrawElements;
+extern GRAPHENE_API PFNGLDRAWELEMENTSINSTANCEDPROC glDrawElementsInstanced;
 extern GRAPHENE_API PFNGLENABLEPROC glEnable;
+extern GRAPHENE_API PFNGLENDQUERYPROC glEndQuery;
 extern GRAPHENE_API PFNGLENABLEVERTEXATTRIBARRAYPROC glEnableVertexAttribArray;
+extern GRAPHENE_API PFNGLFENCESYNCPROC glFenceSync;
+extern GRAPHENE_API PFNGLFLUSHPROC glFlush;
 extern GRAPHENE_API PFNGLFRAMEBUFFERTEXTUREPROC glFramebufferTexture;
 extern GRAPHENE_API PFNGLFRONTFACEPROC glFrontFace;
 extern GRAPHENE_API PFNGLGENBUFFERSPROC glGenBuffers;
 extern GRAPHENE_API PFNGLGENERATEMIPMAPPROC glGenerateMipmap;
 extern GRAPHENE_API PFNGLGENFRAMEBUFFERSPROC glGenFramebuffers;
+extern GRAPHENE_API PFNGLGENQUERIESPROC glGenQueries;
 extern GRAPHENE_API PFNGLGENTEXTURESPROC glGenTextures;
 extern GRAPHENE_API PFNGLGENVERTEXARRAYSPROC glGenVertexArrays;
 extern GRAPHENE_API PFNGLGETACTIVEUNIFORMNAMEPROC glGetActiveUniformName;
@@ -82,7 +95,10 @@ extern GRAPHENE_API PFNGLGETERRORPROC glGetError;
 extern GRAPHENE_API PFNGLGETINTEGERVPROC glGetIntegerv;
 extern GRAPHENE_API PFNGLGETPROGRAMINFOLOGPROC glGetProgramInfoLog;
 extern GRAPHENE_API PFNGLGETPROGRAMIVPROC glGetProgramiv;
+extern GRAPHENE_API PFNGLGETQUERYOBJECTIVPROC glGetQueryObjectiv;
+extern GRAPHENE_API PFNGLGETQUERYOBJECTUI64VPROC glGetQueryObjectui64v;
 extern GRAPHENE_API PFNGLREADPIXELSPROC glReadPixels;
+extern GRAPHENE_API PFNGLSCISSORPROC glScissor;
 extern GRAPHENE_API PFNGLGETSHADERINFOLOGPROC glGetShaderInfoLog;
 extern GRAPHENE_API PFNGLGETSHADERIVPROC glGetShaderiv;
 extern GRAPHENE_API PFNGLGETSTRINGPROC glGetString;
@@ -91,7 +107,9 @@ extern GRAPHENE_API PFNGLGETUNIFORMBLOCKINDEXPROC glGetUniformBlockIndex;
 extern GRAPHENE_API PFNGLGETUNIFORMLOCATIONPROC glGetUniformLocation;
 extern GRAPHENE_API PFNGLLINEWIDTHPROC glLineWidth;
 extern GRAPHENE_API PFNGLLINKPROGRAMPROC glLinkProgram;
+extern GRAPHENE_API PFNGLMAPBUFFERRANGEPROC glMapBufferRange;
 extern GRAPHENE_API PFNGLSHADERSOURCEPROC glShaderSource;
+extern GRAPHENE_API PFNGLTEXBUFFERPROC glTexBuffer;
 extern GRAPHENE_API PFNGLTEXPARAMETERIPROC glTexParameteri;
 extern GRAPHENE_API PFNGLTEXSTORAGE2DPROC glTexStorage2D;
 extern GRAPHENE_API PFNGLTEXSUBIMAGE2DPROC glTexSubImage2D;
@@ -102,12 +120,20 @@ extern GRAPHENE_API PFNGLUNIFORM4FVPROC glUniform4fv;
 extern GRAPHENE_API PFNGLUNIFORMBLOCKBINDINGPROC glUniformBlockBinding;
 extern GRAPHENE_API PFNGLUNIFORMMATRIX3FVPROC glUniformMatrix3fv;
 extern GRAPHENE_API PFNGLUNIFORMMATRIX4FVPROC glUniformMatrix4fv;
+extern GRAPHENE_API PFNGLUNMAPBUFFERPROC glUnmapBuffer;
 extern GRAPHENE_API PFNGLUSEPROGRAMPROC glUseProgram;
+extern GRAPHENE_API PFNGLVERTEXATTRIBDIVISORPROC glVertexAttribDivisor;
 extern GRAPHENE_API PFNGLVERTEXATTRIBPOINTERPROC glVertexAttribPointer;
 extern GRAPHENE_API PFNGLVIEWPORTPROC glViewport;
 
 extern GRAPHENE_API PFNGLDEBUGMESSAGECONTROLARBPROC glDebugMessageControlARB;  // GL_ARB_debug_output
 extern GRAPHENE_API PFNGLDEBUGMESSAGECALLBACKARBPROC glDebugMessageCallbackARB;  // GL_ARB_debug_output
+extern GRAPHENE_API PFNGLBUFFERSTORAGEPROC glBufferStorage;  // GL_ARB_buffer_storage
+extern GRAPHENE_API PFNGLDRAWELEMENTSINSTANCEDBASEINSTANCEPROC glDrawElementsInstancedBaseInstance;  // GL_ARB_base_instance
+extern GRAPHENE_API PFNGLGETPROGRAMBINARYPROC glGetProgramBinary;  // GL_ARB_get_program_binary
+extern GRAPHENE_API PFNGLMAXSHADERCOMPILERTHREADSKHRPROC glMaxShaderCompilerThreadsKHR;  // GL_KHR_parallel_shader_compile
+extern GRAPHENE_API PFNGLPROGRAMBINARYPROC glProgramBinary;  // GL_ARB_get_program_binary
+extern GRAPHENE_API PFNGLPROGRAMPARAMETERIPROC glProgramParameteri;  // GL_ARB_get_program_binary
 
 #if defined(_WIN32)
 extern GRAPHENE_API PFNWGLCHOOSEPIXELFORMATARBPROC wglChoosePixelFormatARB;  // WGL_ARB_pixel_format
@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <PixelReadback.h>
+#include <GLStateCache.h>
+#include <Logger.h>
+#include <stdexcept>
+#include <cstring>
+
+namespace Graphene {
+
+PixelReadback::~PixelReadback() {
+    auto& stateCache = GetGLStateCache();
+
+    for (auto& request: this->requests) {
+        if (request.second.fence != nullptr) {
+            glDeleteSync(request.second.fence);
+        }
+
+        stateCache.deleteBuffer(request.second.buffer);
+    }
+
+    for (auto& freeBuffer: this->freeBuffers) {
+        stateCache.deleteBuffer(freeBuffer.first);
+    }
+}
+
+int PixelReadback::read(GLuint framebuffer, int x, int y, int width, int height, GLenum pixelFormat, GLenum pixelType) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument(LogFormat("Readback region %dx%d is empty", width, height));
+    }
+
+    Request request = { };
+    request.pixelsRowSize = calculatePixelSize(pixelFormat, pixelType) * width;
+    request.rowSize = (request.pixelsRowSize + PIXEL_READBACK_ALIGNMENT - 1) / PIXEL_READBACK_ALIGNMENT * PIXEL_READBACK_ALIGNMENT;
+    request.height = height;
+    request.buffer = this->acquireBuffer(request.rowSize * height, request.bufferSize);
+
+    // Pixels go to the bound pack buffer, the call returns without waiting for them
+    auto& stateCache = GetGLStateCache();
+    stateCache.bindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    stateCache.bindBuffer(GL_PIXEL_PACK_BUFFER, request.buffer);
+    glReadPixels(x, y, width, height, pixelFormat, pixelType, nullptr);
+    stateCache.bindBuffer(GL_PIXEL_PACK_BUFFER, 0);  // Synchronous reads write client memory again
+
+    request.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    int ticket = this->nextTicket++;
+    this->requests[ticket] = request;
+
+    return ticket;
+}
+
+bool PixelReadback::isReady(int ticket) {
+    auto request = this->requests.find(ticket);
+    if (request == this->requests.end()) {
+        throw std::invalid_argument(LogFormat("Readback ticket %d is unknown", ticket));
+    }
+
+    GLsync& fence = request->second.fence;
+    if (fence == nullptr) {
+        return true;
+    }
+
+    // Zero timeout only polls, the flush makes sure the fence gets signaled eventually
+    GLenum waitStatus = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    if (waitStatus == GL_TIMEOUT_EXPIRED) {
+        return false;
+    }
+
+    if (waitStatus == GL_WAIT_FAILED) {
+        LogWarn("Readback ticket %d fence wait failed", ticket);  // Mapping synchronizes anyway
+    }
+
+    glDeleteSync(fence);
+    fence = nullptr;
+
+    return true;
+}
+
+bool PixelReadback::fetch(int ticket, void* pixels) {
+    if (!this->isReady(ticket)) {
+        return false;
+    }
+
+    auto& request = this->requests[ticket];
+    size_t dataSize = request.rowSize * request.height;
+
+    GetGLStateCache().bindBuffer(GL_PIXEL_PACK_BUFFER, request.buffer);
+    auto data = reinterpret_cast<const char*>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, dataSize, GL_MAP_READ_BIT));
+
+    if (data != nullptr) {
+        for (int row = 0; row < request.height; row++) {
+            std::memcpy(reinterpret_cast<char*>(pixels) + request.pixelsRowSize * row, data + request.rowSize * row, request.pixelsRowSize);
+        }
+
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+
+    GetGLStateCache().bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    this->releaseBuffer(request);
+    this->requests.erase(ticket);
+
+    if (data == nullptr) {
+        throw std::runtime_error(LogFormat("Failed to map readback ticket %d", ticket));
+    }
+
+    return true;
+}
+
+void PixelReadback::discard(int ticket) {
+    auto request = this->requests.find(ticket);
+    if (request == this->requests.end()) {
+        throw std::invalid_argument(LogFormat("Readback ticket %d is unknown", ticket));
+    }
+
+    if (request->second.fence != nullptr) {
+        glDeleteSync(request->second.fence);
+    }
+
+    this->releaseBuffer(request->second);
+    this->requests.erase(request);
+}
+
+size_t PixelReadback::calculatePixelSize(GLenum pixelFormat, GLenum pixelType) {
+    size_t components = 0;
+    switch (pixelFormat) {
+        case GL_RED:
+        case GL_RED_INTEGER:
+        case GL_DEPTH_COMPONENT:
+            components = 1;
+            break;
+
+        case GL_RG:
+        case GL_RG_INTEGER:
+            components = 2;
+            break;
+
+        case GL_RGB:
+        case GL_BGR:
+        case GL_RGB_INTEGER:
+            components = 3;
+            break;
+
+        case GL_RGBA:
+        case GL_BGRA:
+        case GL_RGBA_INTEGER:
+            components = 4;
+            break;
+
+        default:
+            throw std::invalid_argument(LogFormat("Pixel format 0x%x is not supported", pixelFormat));
+    }
+
+    switch (pixelType) {
+        case GL_BYTE:
+        case GL_UNSIGNED_BYTE:
+            return components;
+
+        case GL_SHORT:
+        case GL_UNSIGNED_SHORT:
+        case GL_HALF_FLOAT:
+            return components * 2;
+
+        case GL_INT:
+        case GL_UNSIGNED_INT:
+        case GL_FLOAT:
+            return components * 4;
+
+        default:
+            throw std::invalid_argument(LogFormat("Pixel type 0x%x is not supported", pixelType));
+    }
+}
+
+GLuint PixelReadback::acquireBuffer(size_t size, size_t& bufferSize) {
+    // Smallest free buffer that fits, picking reads the same region over and over
+    auto freeBuffer = this->freeBuffers.end();
+    for (auto candidate = this->freeBuffers.begin(); candidate != this->freeBuffers.end(); candidate++) {
+        if (candidate->second >= size && (freeBuffer == this->freeBuffers.end() || candidate->second < freeBuffer->second)) {
+            freeBuffer = candidate;
+        }
+    }
+
+    if (freeBuffer != this->freeBuffers.end()) {
+        GLuint buffer = freeBuffer->first;
+        bufferSize = freeBuffer->second;
+        this->freeBuffers.erase(freeBuffer);
+
+        return buffer;
+    }
+
+    GLuint buffer = 0;
+    glGenBuffers(1, &buffer);
+
+    GetGLStateCache().bindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
+    glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+    GetGLStateCache().bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    bufferSize = size;
+    return buffer;
+}
+
+void PixelReadback::releaseBuffer(Request& request) {
+    if (this->freeBuffers.size() < PIXEL_READBACK_FREE_BUFFERS) {
+        this->freeBuffers.emplace_back(request.buffer, request.bufferSize);
+    } else {
+        GetGLStateCache().deleteBuffer(request.buffer);
+    }
+
+    request.buffer = 0;
+}
+
+}  // namespace Graphene
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef PIXELREADBACK_H
+#define PIXELREADBACK_H
+
+#include <GrapheneApi.h>
+#include <NonCopyable.h>
+#include <OpenGL.h>
+#include <unordered_map>
+#include <cstddef>
+#include <vector>
+
+#define PIXEL_READBACK_ALIGNMENT    4  // GL_PACK_ALIGNMENT default, rows are padded to it
+#define PIXEL_READBACK_FREE_BUFFERS 4
+
+namespace Graphene {
+
+/*
+ * Framebuffer reads into pixel pack buffers. A read returns a ticket at once, the transfer
+ * runs with the rest of the frame and a fence marks its end. Tickets are polled without
+ * waiting, usually a frame or two later. Buffers of fetched tickets are kept for reuse.
+ */
+class PixelReadback: public NonCopyable {
+public:
+    GRAPHENE_API ~PixelReadback();
+
+    // Region of the framebuffer, read from its GL_READ_BUFFER
+    GRAPHENE_API int read(GLuint framebuffer, int x, int y, int width, int height, GLenum pixelFormat, GLenum pixelType);
+
+    GRAPHENE_API bool isReady(int ticket);
+    GRAPHENE_API bool fetch(int ticket, void* pixels);  // Tightly packed rows, false until ready
+    GRAPHENE_API void discard(int ticket);
+
+    GRAPHENE_API static size_t calculatePixelSize(GLenum pixelFormat, GLenum pixelType);
+
+private:
+    typedef struct {
+        GLuint buffer;
+        size_t bufferSize;
+        GLsync fence;
+        size_t rowSize;  // Padded to PIXEL_READBACK_ALIGNMENT
+        size_t pixelsRowSize;
+        int height;
+    } Request;
+
+    GLuint acquireBuffer(size_t size, size_t& bufferSize);
+    void releaseBuffer(Request& request);
+
+    std::unordered_map<int, Request> requests;
+    std::vector<std::pair<GLuint, size_t>> freeBuffers;  // Handle and size
+    int nextTicket = 0;
+};
+
+}  // namespace Graphene
+
+#endif  // PIXELREADBACK_H
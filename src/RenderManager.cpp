@@ -23,8 +23,10 @@
 #include <RenderManager.h>
 #include <RenderState.h>
 #include <ObjectManager.h>
+#include <GLStateCache.h>
 #include <Logger.h>
 #include <stdexcept>
+#include <algorithm>
 
 namespace Graphene {
 
@@ -37,17 +39,20 @@ RenderManager::RenderManager() {
     auto& objectManager = GetObjectManager();
 
     this->frame = objectManager.createQuad(FaceWinding::WINDING_CLOCKWISE);
+    this->dynamicVertexBuffer = std::make_shared<DynamicBuffer>(GL_ARRAY_BUFFER, 1024 * 1024);
+    this->dynamicUniformBuffer = std::make_shared<DynamicBuffer>(GL_UNIFORM_BUFFER, 256 * 1024);
     auto& shader = objectManager.createShader();
 
     this->renderStates = {
-        { RenderGeometry::INDEX, std::make_shared<RenderGeometry>() },
-        { RenderOverlay::INDEX,  std::make_shared<RenderOverlay>() },
-        { RenderBuffer::INDEX,   std::make_shared<RenderBuffer>() },
-        { RenderSkybox::INDEX,   std::make_shared<RenderSkybox>() },
-        { RenderFrame::INDEX,    std::make_shared<RenderFrame>() },
-        { RenderShadows::INDEX,  std::make_shared<RenderShadows>() },
-        { RenderLights::INDEX,   std::make_shared<RenderLights>() },
-        { RenderNone::INDEX,     std::make_shared<RenderNone>() }
+        { RenderGeometry::INDEX,      std::make_shared<RenderGeometry>() },
+        { RenderOverlay::INDEX,       std::make_shared<RenderOverlay>() },
+        { RenderBuffer::INDEX,        std::make_shared<RenderBuffer>() },
+        { RenderSkybox::INDEX,        std::make_shared<RenderSkybox>() },
+        { RenderFrame::INDEX,         std::make_shared<RenderFrame>() },
+        { RenderShadows::INDEX,       std::make_shared<RenderShadows>() },
+        { RenderLights::INDEX,        std::make_shared<RenderLights>() },
+        { RenderLightClusters::INDEX, std::make_shared<RenderLightClusters>() },
+        { RenderNone::INDEX,          std::make_shared<RenderNone>() }
     };
 
     this->getRenderState(RenderNone::ID)->setShader(shader);
@@ -70,10 +75,75 @@ bool RenderManager::hasLightPass() const {
     return this->lightPass;
 }
 
+void RenderManager::setClusteredLighting(bool clusteredLighting) {
+    this->clusteredLighting = clusteredLighting;
+}
+
+bool RenderManager::hasClusteredLighting() const {
+    return this->clusteredLighting;
+}
+
+void RenderManager::setOcclusionCulling(bool occlusionCulling) {
+    this->occlusionCulling = occlusionCulling;
+}
+
+bool RenderManager::hasOcclusionCulling() const {
+    return this->occlusionCulling;
+}
+
+void RenderManager::setOcclusionQueries(bool occlusionQueries) {
+    this->occlusionQueries = occlusionQueries;
+}
+
+bool RenderManager::hasOcclusionQueries() const {
+    return this->occlusionQueries;
+}
+
+void RenderManager::setDepthPrepass(bool depthPrepass) {
+    this->depthPrepass = depthPrepass;
+}
+
+bool RenderManager::hasDepthPrepass() const {
+    return this->depthPrepass;
+}
+
 const std::shared_ptr<Mesh>& RenderManager::getFrame() const {
     return this->frame;
 }
 
+const GLint* RenderManager::getViewport() const {
+    return this->viewport;
+}
+
+const std::shared_ptr<DynamicBuffer>& RenderManager::getDynamicVertexBuffer() const {
+    return this->dynamicVertexBuffer;
+}
+
+const std::shared_ptr<DynamicBuffer>& RenderManager::getDynamicUniformBuffer() const {
+    return this->dynamicUniformBuffer;
+}
+
+RenderStats& RenderManager::getRenderStats() {
+    return this->renderStats;
+}
+
+void RenderManager::resetRenderStats() {
+    this->renderStats = { };
+}
+
+void RenderManager::beginFrame() {
+    this->resetRenderStats();
+    GetGLStateCache().resetCounters();
+
+    this->dynamicVertexBuffer->beginFrame();
+    this->dynamicUniformBuffer->beginFrame();
+}
+
+void RenderManager::endFrame() {
+    this->dynamicVertexBuffer->endFrame();
+    this->dynamicUniformBuffer->endFrame();
+}
+
 void RenderManager::setRenderState(MetaType stateType) {
     this->renderState = this->renderStates.at(MetaIndex(stateType));
     this->renderState->enter(this);
@@ -83,19 +153,29 @@ const std::shared_ptr<RenderState>& RenderManager::getRenderState(MetaType state
     return this->renderStates.at(MetaIndex(stateType));
 }
 
-void RenderManager::update(const std::shared_ptr<Camera>& camera) {
+void RenderManager::update(const std::shared_ptr<Camera>& camera, const GLint viewport[4]) {
     if (camera == nullptr) {
         throw std::invalid_argument(LogFormat("Camera cannot be nullptr"));
     }
 
+    std::copy(viewport, viewport + 4, this->viewport);  // Set by the caller, never queried back
+
     auto renderNone = this->getRenderState(RenderNone::ID);
     while (this->renderState != renderNone) {
+        // Skip the pass chain rather than stall the frame on a shader still compiling
+        if (!this->renderState->getShader()->isReady()) {
+            this->setRenderState(RenderNone::ID);
+            break;
+        }
+
         this->setRenderState(this->renderState->update(this, camera));
     }
 }
 
 void RenderManager::teardown() {
     this->renderStates.clear();
+    this->dynamicVertexBuffer.reset();
+    this->dynamicUniformBuffer.reset();
 }
 
 }  // namespace Graphene
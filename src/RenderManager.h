@@ -29,6 +29,8 @@
 #include <MetaObject.h>
 #include <Camera.h>
 #include <Mesh.h>
+#include <DynamicBuffer.h>
+#include <OpenGL.h>
 #include <unordered_map>
 #include <memory>
 
@@ -36,6 +38,12 @@
 
 namespace Graphene {
 
+typedef struct {
+    int visibleLights;
+    int culledLights;
+    int occludedEntities;
+} RenderStats;
+
 class RenderManager: public NonCopyable {
 public:
     GRAPHENE_API static RenderManager& getInstance();
@@ -46,12 +54,34 @@ public:
     GRAPHENE_API void setLightPass(bool lightPass);
     GRAPHENE_API bool hasLightPass() const;
 
+    GRAPHENE_API void setClusteredLighting(bool clusteredLighting);
+    GRAPHENE_API bool hasClusteredLighting() const;
+
+    GRAPHENE_API void setOcclusionCulling(bool occlusionCulling);  // Against entities flagged as occluders
+    GRAPHENE_API bool hasOcclusionCulling() const;
+
+    GRAPHENE_API void setOcclusionQueries(bool occlusionQueries);  // GPU tested boxes of heavy entities, a frame late
+    GRAPHENE_API bool hasOcclusionQueries() const;
+
+    GRAPHENE_API void setDepthPrepass(bool depthPrepass);  // Off sorts opaque draws roughly front to back instead
+    GRAPHENE_API bool hasDepthPrepass() const;
+
     GRAPHENE_API const std::shared_ptr<Mesh>& getFrame() const;
+    GRAPHENE_API const GLint* getViewport() const;  // Left, bottom, width, height of the camera being rendered
+
+    GRAPHENE_API const std::shared_ptr<DynamicBuffer>& getDynamicVertexBuffer() const;
+    GRAPHENE_API const std::shared_ptr<DynamicBuffer>& getDynamicUniformBuffer() const;
+
+    GRAPHENE_API RenderStats& getRenderStats();  // Accumulated over all cameras until reset
+    GRAPHENE_API void resetRenderStats();
+
+    GRAPHENE_API void beginFrame();  // Resets stats and state counters, waits for the dynamic buffers region
+    GRAPHENE_API void endFrame();
 
     GRAPHENE_API void setRenderState(MetaType stateType);
     GRAPHENE_API const std::shared_ptr<RenderState>& getRenderState(MetaType stateType) const;
 
-    GRAPHENE_API void update(const std::shared_ptr<Camera>& camera);
+    GRAPHENE_API void update(const std::shared_ptr<Camera>& camera, const GLint viewport[4]);
 
     GRAPHENE_API void teardown();
 
@@ -60,8 +90,16 @@ private:
 
     bool shadowPass = false;
     bool lightPass = false;
+    bool clusteredLighting = false;
+    bool occlusionCulling = false;
+    bool occlusionQueries = false;
+    bool depthPrepass = false;
 
     std::shared_ptr<Mesh> frame;
+    GLint viewport[4] = { };
+    std::shared_ptr<DynamicBuffer> dynamicVertexBuffer;
+    std::shared_ptr<DynamicBuffer> dynamicUniformBuffer;
+    RenderStats renderStats = { };
 
     std::unordered_map<MetaIndex, std::shared_ptr<RenderState>> renderStates;
     std::shared_ptr<RenderState> renderState;
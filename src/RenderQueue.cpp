@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <RenderQueue.h>
+#include <Texture.h>
+#include <UniformBuffer.h>
+#include <algorithm>
+#include <cmath>
+
+#define SORT_KEY_BITS    16
+#define SORT_KEY_MASK    ((1u << SORT_KEY_BITS) - 1)
+#define MATERIAL_BITS    11
+#define BUCKET_BITS      4
+#define RADIX_BITS       8
+#define RADIX_BUCKETS    (1 << RADIX_BITS)
+
+namespace Graphene {
+
+static void transpose(const Math::Mat4& matrix, float columnMajor[16]) {
+    const float* rowMajor = matrix.data();
+
+    for (int row = 0; row < 4; row++) {
+        for (int column = 0; column < 4; column++) {
+            columnMajor[column * 4 + row] = rowMajor[row * 4 + column];
+        }
+    }
+}
+
+static uint64_t calculateDepthKey(float depth) {
+    return static_cast<uint64_t>(std::min(std::max(depth, 0.0f), 1.0f) * SORT_KEY_MASK);
+}
+
+static uint64_t calculateBucketKey(float depth) {
+    // Square root spreads the buckets over the near range, where most of the overdraw is
+    return static_cast<uint64_t>(std::sqrt(std::min(std::max(depth, 0.0f), 1.0f)) * ((1u << BUCKET_BITS) - 1) + 0.5f);
+}
+
+uint64_t RenderQueue::calculateSortKey(const Material* material, const Mesh* mesh, float depth, bool frontToBack) {
+    // Only the low bits of the ids are kept, collisions cost extra binds but not correctness
+    auto& texture = material->getDiffuseTexture();
+    uint64_t bucketKey = frontToBack ? calculateBucketKey(depth) : 0;
+    uint64_t texturedKey = (texture != nullptr) ? 1 : 0;  // Textured and plain draws use distinct programs
+    uint64_t textureKey = (texture != nullptr) ? (texture->getHandle() & SORT_KEY_MASK) : 0;
+    uint64_t materialKey = static_cast<uint64_t>(material->getId()) & ((1u << MATERIAL_BITS) - 1);
+    uint64_t meshKey = static_cast<uint64_t>(mesh->getId()) & SORT_KEY_MASK;
+    uint64_t depthKey = calculateDepthKey(depth);
+
+    return (bucketKey << (SORT_KEY_BITS * 4 - BUCKET_BITS)) | (texturedKey << (SORT_KEY_BITS * 3 + MATERIAL_BITS)) |
+            (materialKey << (SORT_KEY_BITS * 3)) | (textureKey << (SORT_KEY_BITS * 2)) | (meshKey << SORT_KEY_BITS) | depthKey;
+}
+
+uint64_t RenderQueue::calculateDepthSortKey(const Mesh* mesh, float depth) {
+    uint64_t bucketKey = calculateBucketKey(depth);
+    uint64_t meshKey = static_cast<uint64_t>(mesh->getId()) & SORT_KEY_MASK;
+    uint64_t depthKey = calculateDepthKey(depth);
+
+    return (bucketKey << (SORT_KEY_BITS * 2)) | (meshKey << SORT_KEY_BITS) | depthKey;
+}
+
+int RenderQueue::addTransformation(const Math::Mat4& localWorld, const Math::Mat4& normalRotation) {
+    InstanceData transformation;
+    transpose(localWorld, transformation.localWorld);
+    transpose(normalRotation, transformation.normalRotation);
+    this->transformations.push_back(transformation);
+
+    return static_cast<int>(this->transformations.size()) - 1;
+}
+
+void RenderQueue::addItem(uint64_t sortKey, Material* material, Mesh* mesh, int transformation) {
+    this->items.push_back({ sortKey, material, mesh, transformation });
+}
+
+const std::vector<RenderItem>& RenderQueue::getItems() const {
+    return this->items;
+}
+
+void RenderQueue::sort() {
+    size_t itemsCount = this->items.size();
+    this->sortedItems.resize(itemsCount);
+
+    // LSD radix sort, stable so equal keys keep submission order
+    for (int shift = 0; shift < 64; shift += RADIX_BITS) {
+        size_t offsets[RADIX_BUCKETS] = { };
+
+        for (auto& item: this->items) {
+            offsets[(item.sortKey >> shift) & (RADIX_BUCKETS - 1)]++;
+        }
+
+        // All keys share the digit, the pass would not move anything
+        if (std::find(offsets, offsets + RADIX_BUCKETS, itemsCount) != offsets + RADIX_BUCKETS) {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (auto& bucketOffset: offsets) {
+            size_t bucketSize = bucketOffset;
+            bucketOffset = offset;
+            offset += bucketSize;
+        }
+
+        for (auto& item: this->items) {
+            this->sortedItems[offsets[(item.sortKey >> shift) & (RADIX_BUCKETS - 1)]++] = item;
+        }
+
+        this->items.swap(this->sortedItems);
+    }
+}
+
+void RenderQueue::submit(const std::shared_ptr<DynamicBuffer>& instanceBuffer, const MaterialHandler& handler) {
+    if (this->items.empty()) {
+        return;
+    }
+
+    size_t instancesOffset = this->writeInstances(instanceBuffer);
+
+    Material* activeMaterial = nullptr;
+    Texture* activeTexture = nullptr;
+    size_t itemsCount = this->items.size();
+
+    for (size_t first = 0, last = 0; first < itemsCount; first = last) {
+        auto& item = this->items[first];
+
+        last = first + 1;
+        while (last < itemsCount && this->items[last].material == item.material && this->items[last].mesh == item.mesh) {
+            last++;
+        }
+
+        if (item.material != activeMaterial) {
+            handler(item.material);
+            item.material->bind(BIND_MATERIAL);
+            activeMaterial = item.material;
+
+            auto texture = item.material->getDiffuseTexture().get();
+            if (texture != nullptr && texture != activeTexture) {
+                texture->bind(TEXTURE_DIFFUSE);
+                activeTexture = texture;
+            }
+        }
+
+        item.mesh->renderInstanced(instanceBuffer, instancesOffset + sizeof(InstanceData) * first, static_cast<int>(last - first));
+    }
+}
+
+void RenderQueue::submitDepth(const std::shared_ptr<DynamicBuffer>& instanceBuffer) {
+    if (this->items.empty()) {
+        return;
+    }
+
+    size_t instancesOffset = this->writeInstances(instanceBuffer);
+    size_t itemsCount = this->items.size();
+
+    for (size_t first = 0, last = 0; first < itemsCount; first = last) {
+        auto& item = this->items[first];
+
+        last = first + 1;
+        while (last < itemsCount && this->items[last].mesh == item.mesh) {
+            last++;
+        }
+
+        item.mesh->renderInstanced(instanceBuffer, instancesOffset + sizeof(InstanceData) * first, static_cast<int>(last - first));
+    }
+}
+
+void RenderQueue::submitEach(const std::shared_ptr<DynamicBuffer>& instanceBuffer, const ItemHandler& before, const ItemHandler& after) {
+    if (this->items.empty()) {
+        return;
+    }
+
+    size_t instancesOffset = this->writeInstances(instanceBuffer);
+    size_t itemsCount = this->items.size();
+
+    // Handlers bracket every item, items are addressed in the order the queue holds them
+    for (size_t item = 0; item < itemsCount; item++) {
+        before(item);
+        this->items[item].mesh->renderInstanced(instanceBuffer, instancesOffset + sizeof(InstanceData) * item, 1);
+        after(item);
+    }
+}
+
+void RenderQueue::clear() {
+    this->items.clear();
+    this->transformations.clear();
+}
+
+size_t RenderQueue::writeInstances(const std::shared_ptr<DynamicBuffer>& instanceBuffer) {
+    // Single write of every instance of the queue, runs draw from their own ranges
+    this->instances.clear();
+    for (auto& item: this->items) {
+        this->instances.push_back(this->transformations[item.transformation]);
+    }
+
+    return instanceBuffer->write(this->instances.data(), sizeof(InstanceData) * this->instances.size(), sizeof(InstanceData));
+}
+
+}  // namespace Graphene
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef RENDERQUEUE_H
+#define RENDERQUEUE_H
+
+#include <GrapheneApi.h>
+#include <NonCopyable.h>
+#include <Material.h>
+#include <Mesh.h>
+#include <DynamicBuffer.h>
+#include <Mat4.h>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <memory>
+
+namespace Graphene {
+
+/*
+ * Sort key layout, most significant first:
+ *     | depth bucket: 4 | textured: 1 | material: 11 | texture: 16 | mesh: 16 | depth: 16 |
+ * Draws sharing state end up adjacent, ties are ordered front to back. The coarse depth bucket
+ * trades some batching for less overdraw, it is left zero when depth is laid down beforehand.
+ * Depth only keys skip the material:
+ *     | depth bucket: 4 | mesh: 16 | depth: 16 |
+ * Adjacent items of the same material and mesh are drawn as a single instanced draw.
+ */
+typedef struct {
+    uint64_t sortKey;
+    Material* material;  // Owned by the scene for the lifetime of the queue, unused by depth only queues
+    Mesh* mesh;
+    int transformation;
+} RenderItem;
+
+typedef std::function<void(const Material* material)> MaterialHandler;  // Called before a material is bound
+typedef std::function<void(size_t item)> ItemHandler;  // Called around a single item draw
+
+class RenderQueue: public NonCopyable {
+public:
+    GRAPHENE_API static uint64_t calculateSortKey(const Material* material, const Mesh* mesh, float depth, bool frontToBack);
+    GRAPHENE_API static uint64_t calculateDepthSortKey(const Mesh* mesh, float depth);
+
+    GRAPHENE_API int addTransformation(const Math::Mat4& localWorld, const Math::Mat4& normalRotation);
+    GRAPHENE_API void addItem(uint64_t sortKey, Material* material, Mesh* mesh, int transformation);
+
+    GRAPHENE_API const std::vector<RenderItem>& getItems() const;
+
+    GRAPHENE_API void sort();
+    GRAPHENE_API void submit(const std::shared_ptr<DynamicBuffer>& instanceBuffer, const MaterialHandler& handler);
+    GRAPHENE_API void submitDepth(const std::shared_ptr<DynamicBuffer>& instanceBuffer);  // Meshes only, no materials bound
+    GRAPHENE_API void submitEach(const std::shared_ptr<DynamicBuffer>& instanceBuffer, const ItemHandler& before, const ItemHandler& after);  // Not instanced
+    GRAPHENE_API void clear();
+
+private:
+    struct InstanceData {
+        float localWorld[16];  // Column-major, as read by mat4 vertex attributes
+        float normalRotation[16];
+    };
+
+    size_t writeInstances(const std::shared_ptr<DynamicBuffer>& instanceBuffer);
+
+    std::vector<RenderItem> items;
+    std::vector<RenderItem> sortedItems;  // Radix sort scratch
+
+    std::vector<InstanceData> transformations;
+    std::vector<InstanceData> instances;  // Transformations in sorted items order
+};
+
+}  // namespace Graphene
+
+#endif  // RENDERQUEUE_H
@@ -23,26 +23,136 @@
 #include <RenderState.h>
 #include <RenderManager.h>
 #include <GraphicsComponent.h>
+#include <GLStateCache.h>
 #include <Texture.h>
 #include <Logger.h>
 #include <Scene.h>
 #include <Light.h>
 #include <Entity.h>
+#include <Frustum.h>
 #include <Mat4.h>
+#include <Vec4.h>
+#include <algorithm>
 #include <stdexcept>
+#include <thread>
+#include <vector>
+#include <cmath>
+
+#define CLUSTERED_LIGHTS_MAX 256  // 16KiB, minimal GL_MAX_UNIFORM_BLOCK_SIZE
 
 namespace Graphene {
 
+#pragma pack(push, 1)
+
+/* std140 layout, see clustered_lighting.shader */
+typedef struct {
+    float position[3];
+    float range;
+    float direction[3];
+    int type;
+    float color[3];
+    float energy;
+    float falloff;
+    float angle;
+    float blend;
+    float padding;
+} ClusteredLight;
+
+#pragma pack(pop)
+
+static std::shared_ptr<Shader> selectPermutation(const std::shared_ptr<Shader>& shader, const std::vector<std::string>& defines) {
+    // Generic program branches at runtime, it stands in while the variant is built
+    auto& permutation = shader->getPermutation(defines);
+    return permutation->isReady() ? permutation : shader;
+}
+
+static int calculateFaces(const std::shared_ptr<Entity>& entity) {
+    int faces = 0;
+
+    for (auto& component: entity->getComponents()) {
+        if (component->isA<GraphicsComponent>()) {
+            for (auto& mesh: component->toA<GraphicsComponent>()->getMeshes()) {
+                faces += mesh->getFaces();
+            }
+        }
+    }
+
+    return faces;
+}
+
+static MetaType selectLightPass(RenderManager* renderManager, const std::shared_ptr<Camera>& camera) {
+    // Froxel grid depth slicing is defined for perspective projection only
+    if (renderManager->hasClusteredLighting() && camera->getProjectionType() == ProjectionType::PERSPECTIVE) {
+        return RenderLightClusters::ID;
+    }
+
+    return RenderLights::ID;
+}
+
+static bool calculateScissor(const Math::Vec3& position, float range, const Math::Mat4& modelViewProjection,
+        const GLint viewport[4], GLint scissor[4]) {
+    float minX = 1.0f, maxX = -1.0f;
+    float minY = 1.0f, maxY = -1.0f;
+
+    // Project the corners of the sphere's bounding box, bail out to the full viewport
+    // if any of them is behind the camera and the projection is not defined
+    for (int corner = 0; corner < 8; corner++) {
+        Math::Vec3 offset((corner & 1) ? range : -range, (corner & 2) ? range : -range, (corner & 4) ? range : -range);
+        Math::Vec4 clipCorner(modelViewProjection * Math::Vec4(position + offset, 1.0f));
+
+        float w = clipCorner.get(Math::Vec4::W);
+        if (w <= 0.0f) {
+            std::copy(viewport, viewport + 4, scissor);
+            return true;
+        }
+
+        float x = clipCorner.get(Math::Vec4::X) / w;
+        float y = clipCorner.get(Math::Vec4::Y) / w;
+
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+    }
+
+    minX = std::max(minX, -1.0f);
+    maxX = std::min(maxX, 1.0f);
+    minY = std::max(minY, -1.0f);
+    maxY = std::min(maxY, 1.0f);
+
+    if (minX >= maxX || minY >= maxY) {
+        return false;  // Off screen
+    }
+
+    GLint left = viewport[0] + static_cast<GLint>(floorf((minX + 1.0f) / 2.0f * viewport[2]));
+    GLint right = viewport[0] + static_cast<GLint>(ceilf((maxX + 1.0f) / 2.0f * viewport[2]));
+    GLint bottom = viewport[1] + static_cast<GLint>(floorf((minY + 1.0f) / 2.0f * viewport[3]));
+    GLint top = viewport[1] + static_cast<GLint>(ceilf((maxY + 1.0f) / 2.0f * viewport[3]));
+
+    scissor[0] = left;
+    scissor[1] = bottom;
+    scissor[2] = right - left;
+    scissor[3] = top - bottom;
+
+    return true;
+}
+
 void RenderState::setShader(const std::shared_ptr<Shader>& shader) {
     this->shader = shader;
+    this->activeShader = shader;
 }
 
 const std::shared_ptr<Shader>& RenderState::getShader() const {
     return this->shader;
 }
 
+const std::shared_ptr<Shader>& RenderState::getActiveShader() const {
+    return this->activeShader;
+}
+
 void RenderState::setCallback(const RenderStateCallback& callback) {
     this->callback = callback;
+    this->callbackSet = true;
 }
 
 const RenderStateCallback& RenderState::getCallback() const {
@@ -50,7 +160,9 @@ const RenderStateCallback& RenderState::getCallback() const {
 }
 
 void RenderState::enter(RenderManager* /*renderManager*/) {
-    this->shader->enable();
+    if (this->shader->isReady()) {
+        this->shader->enable();
+    }
 }
 
 MetaType RenderState::update(RenderManager* /*renderManager*/, const std::shared_ptr<Camera>& camera) {
@@ -58,13 +170,17 @@ MetaType RenderState::update(RenderManager* /*renderManager*/, const std::shared
 
     this->shader->setUniformBlock("Material", BIND_MATERIAL);
     this->shader->setUniform("diffuseSampler", TEXTURE_DIFFUSE);
-    this->shader->setUniform("modelViewProjection", camera->getProjection() * Scene::calculateModelView(camera));
+    Math::Mat4 modelViewProjection(camera->getProjection() * Scene::calculateModelView(camera));
+    this->shader->setUniform("modelViewProjection", modelViewProjection);
+
+    auto localWorldUniform = this->shader->getUniform<Math::Mat4>("localWorld");
+    auto normalRotationUniform = this->shader->getUniform<Math::Mat4>("normalRotation");
 
-    scene->iterateEntities([this](const std::shared_ptr<Entity>& entity, const Math::Mat4& localWorld, const Math::Mat4& normalRotation) {
+    scene->iterateEntities(Frustum(modelViewProjection), [this, &localWorldUniform, &normalRotationUniform](const std::shared_ptr<Entity>& entity, const Math::Mat4& localWorld, const Math::Mat4& normalRotation) {
         this->callback(this, entity);
 
-        this->shader->setUniform("localWorld", localWorld);
-        this->shader->setUniform("normalRotation", normalRotation);
+        localWorldUniform.set(localWorld);
+        normalRotationUniform.set(normalRotation);
 
         for (auto& component: entity->getComponents()) {
             if (component->isA<GraphicsComponent>()) {
@@ -76,6 +192,215 @@ MetaType RenderState::update(RenderManager* /*renderManager*/, const std::shared
     return RenderSkybox::ID;
 }
 
+MetaType RenderGeometry::update(RenderManager* renderManager, const std::shared_ptr<Camera>& camera) {
+    auto scene = camera->getScene();
+    Math::Mat4 modelViewProjection(camera->getProjection() * Scene::calculateModelView(camera));
+
+    auto texturedShader = selectPermutation(this->shader, { "HAS_DIFFUSE_TEXTURE=true" });
+    auto plainShader = selectPermutation(this->shader, { "HAS_DIFFUSE_TEXTURE=false" });
+    std::shared_ptr<Shader> depthShader;
+    if (renderManager->hasDepthPrepass() || renderManager->hasOcclusionQueries()) {
+        depthShader = this->shader->getPermutation({ "DEPTH_ONLY=true" });
+    }
+
+    // No stand in for the depth program, frames go without the pre-pass and queries until it is built
+    bool depthReady = depthShader != nullptr && depthShader->isReady();
+    bool depthPrepass = depthReady && renderManager->hasDepthPrepass();
+
+    for (auto cameraQueries = this->occlusionQueries.begin(); cameraQueries != this->occlusionQueries.end(); ) {
+        if (cameraQueries->second.camera.expired()) {
+            cameraQueries = this->occlusionQueries.erase(cameraQueries);
+        } else {
+            cameraQueries++;
+        }
+    }
+
+    std::shared_ptr<OcclusionQueries> occlusionQueries;
+    if (depthReady && renderManager->hasOcclusionQueries()) {
+        auto& cameraQueries = this->occlusionQueries[camera->getId()];
+        if (cameraQueries.queries == nullptr) {
+            cameraQueries.camera = camera;
+            cameraQueries.queries = std::make_shared<OcclusionQueries>();
+        }
+
+        occlusionQueries = cameraQueries.queries;
+        occlusionQueries->begin(Scene::calculatePosition(camera), camera->getNearPlane());
+    }
+
+    for (auto& shader: { texturedShader, plainShader }) {
+        shader->setUniformBlock("Material", BIND_MATERIAL);
+        shader->setUniform("diffuseSampler", TEXTURE_DIFFUSE);
+        shader->setUniform("modelViewProjection", modelViewProjection);
+    }
+
+    float farPlane = camera->getFarPlane();
+    auto& renderStats = renderManager->getRenderStats();
+    this->renderQueue.clear();
+    this->depthQueue.clear();
+    this->callbackQueue.clear();
+
+    auto enqueueEntity = [this, &modelViewProjection, farPlane, depthPrepass, &occlusionQueries, &renderStats](const std::shared_ptr<Entity>& entity, const Math::Mat4& localWorld, const Math::Mat4& normalRotation) {
+        // Last frame's query result, hidden entities are queried again for the next one
+        if (occlusionQueries != nullptr && calculateFaces(entity) >= OCCLUSION_QUERY_FACES_MIN &&
+                !occlusionQueries->isVisible(entity->getId(), entity->getBoundingBox().transform(localWorld))) {
+            renderStats.occludedEntities++;
+            return;
+        }
+
+        // Clip space w is the view space distance for perspective projection
+        Math::Vec4 position(localWorld.get(0, 3), localWorld.get(1, 3), localWorld.get(2, 3), 1.0f);
+        float depth = (modelViewProjection * position).get(Math::Vec4::W) / farPlane;
+        int transformation = -1;
+        int depthTransformation = -1;
+        auto& queue = this->callbackSet ? this->callbackQueue : this->renderQueue;
+
+        for (auto& component: entity->getComponents()) {
+            if (!component->isA<GraphicsComponent>()) {
+                continue;
+            }
+
+            auto graphicsComponent = component->toA<GraphicsComponent>();
+            auto& materials = graphicsComponent->getMaterials();
+            auto& meshes = graphicsComponent->getMeshes();
+
+            for (size_t i = 0; i < materials.size(); i++) {
+                if (transformation == -1) {
+                    transformation = queue.addTransformation(localWorld, normalRotation);
+                }
+
+                auto material = materials[i].get();
+                auto mesh = meshes[i].get();
+                queue.addItem(RenderQueue::calculateSortKey(material, mesh, depth, !depthPrepass), material, mesh, transformation);
+
+                if (this->callbackSet) {
+                    this->callbackEntities.push_back(entity);
+                }
+
+                if (depthPrepass) {
+                    if (depthTransformation == -1) {
+                        depthTransformation = this->depthQueue.addTransformation(localWorld, normalRotation);
+                    }
+
+                    this->depthQueue.addItem(RenderQueue::calculateDepthSortKey(mesh, depth), nullptr, mesh, depthTransformation);
+                }
+            }
+        }
+    };
+
+    Frustum frustum(modelViewProjection);
+    if (!renderManager->hasOcclusionCulling()) {
+        scene->iterateEntities(frustum, enqueueEntity);
+    } else {
+        if (this->occlusionBuffer == nullptr) {
+            int workers = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+            workers = std::min(std::max(workers, 0), OCCLUSION_WORKERS_MAX);
+            this->occlusionBuffer = std::make_shared<OcclusionBuffer>(OCCLUSION_BUFFER_WIDTH, OCCLUSION_BUFFER_HEIGHT, workers);
+        }
+
+        // Occluders go into the buffer first, everything else is tested against it
+        this->occlusionBuffer->clear(modelViewProjection);
+        this->occlusionCandidates.clear();
+
+        scene->iterateEntities(frustum, [this](const std::shared_ptr<Entity>& entity, const Math::Mat4& localWorld, const Math::Mat4& normalRotation) {
+            this->occlusionCandidates.push_back({ entity, localWorld, normalRotation });
+            if (!entity->isOccluder()) {
+                return;
+            }
+
+            for (auto& component: entity->getComponents()) {
+                if (component->isA<GraphicsComponent>()) {
+                    for (auto& mesh: component->toA<GraphicsComponent>()->getMeshes()) {
+                        if (mesh->hasGeometry()) {
+                            this->occlusionBuffer->addOccluder(mesh->getPositions(), mesh->getIndices(), localWorld);
+                        }
+                    }
+                }
+            }
+        });
+
+        this->occlusionBuffer->rasterize();
+
+        for (auto& candidate: this->occlusionCandidates) {
+            auto& entity = candidate.entity;
+            if (entity->isOccluder() || this->occlusionBuffer->isVisible(entity->getBoundingBox().transform(candidate.localWorld))) {
+                enqueueEntity(entity, candidate.localWorld, candidate.normalRotation);
+            } else {
+                renderStats.occludedEntities++;
+            }
+        }
+
+        this->occlusionCandidates.clear();  // Releases the entities
+    }
+
+    auto& stateCache = GetGLStateCache();
+    auto& instanceBuffer = renderManager->getDynamicVertexBuffer();
+
+    if (depthPrepass) {
+        // Depth is laid down front to back, the G-buffer is then written once per pixel
+        depthShader->setUniform("modelViewProjection", modelViewProjection);
+        depthShader->enable();
+
+        stateCache.colorMask(GL_FALSE);
+        this->depthQueue.sort();
+        this->depthQueue.submitDepth(instanceBuffer);
+        stateCache.colorMask(GL_TRUE);
+
+        stateCache.depthMask(GL_FALSE);
+        stateCache.depthFunc(GL_EQUAL);
+    }
+
+    this->renderQueue.sort();
+    this->renderQueue.submit(instanceBuffer, [&texturedShader, &plainShader](const Material* material) {
+        if (material->getDiffuseTexture() != nullptr) {
+            texturedShader->enable();
+        } else {
+            plainShader->enable();
+        }
+    });
+
+    // Whatever the callback sets applies to its own entity draw only, nothing is batched
+    auto& callbackItems = this->callbackQueue.getItems();
+    this->callbackQueue.submitEach(instanceBuffer, [this, &callbackItems, &texturedShader, &plainShader](size_t item) {
+        auto material = callbackItems[item].material;
+        auto& texture = material->getDiffuseTexture();
+
+        if (texture != nullptr) {
+            this->activeShader = texturedShader;
+            texture->bind(TEXTURE_DIFFUSE);
+        } else {
+            this->activeShader = plainShader;
+        }
+
+        this->activeShader->enable();
+        material->bind(BIND_MATERIAL);
+        this->callback(this, this->callbackEntities[item]);
+    }, [](size_t /*item*/) { });
+
+    this->callbackEntities.clear();  // Releases the entities
+    this->activeShader = this->shader;  // Releases the permutation
+
+    if (depthPrepass) {
+        stateCache.depthMask(GL_TRUE);
+        stateCache.depthFunc(GL_LEQUAL);  // Skybox default, see Engine::setupOpenGL()
+    }
+
+    if (occlusionQueries != nullptr) {
+        // Boxes are tested against the finished depth, both sides in case the near plane cuts one
+        depthShader->setUniform("modelViewProjection", modelViewProjection);
+        depthShader->enable();
+
+        stateCache.colorMask(GL_FALSE);
+        stateCache.depthMask(GL_FALSE);
+        stateCache.disable(GL_CULL_FACE);
+        occlusionQueries->submit(instanceBuffer);
+        stateCache.enable(GL_CULL_FACE);
+        stateCache.depthMask(GL_TRUE);
+        stateCache.colorMask(GL_TRUE);
+    }
+
+    return RenderSkybox::ID;
+}
+
 MetaType RenderSkybox::update(RenderManager* /*renderManager*/, const std::shared_ptr<Camera>& camera) {
     auto scene = camera->getScene();
     auto& skybox = scene->getSkybox();
@@ -116,15 +441,15 @@ MetaType RenderFrame::update(RenderManager* renderManager, const std::shared_ptr
     }
 
     if (renderManager->hasLightPass()) {
-        return RenderLights::ID;
+        return selectLightPass(renderManager, camera);
     }
 
     return RenderNone::ID;
 }
 
-MetaType RenderShadows::update(RenderManager* renderManager, const std::shared_ptr<Camera>& /*camera*/) {
+MetaType RenderShadows::update(RenderManager* renderManager, const std::shared_ptr<Camera>& camera) {
     if (renderManager->hasLightPass()) {
-        return RenderLights::ID;
+        return selectLightPass(renderManager, camera);
     }
 
     return RenderNone::ID;
@@ -134,23 +459,167 @@ MetaType RenderLights::update(RenderManager* renderManager, const std::shared_pt
     auto scene = camera->getScene();
     auto& frame = renderManager->getFrame();
 
-    this->shader->setUniformBlock("Light", BIND_LIGHT);
+    const GLint* viewport = renderManager->getViewport();
+    Math::Mat4 modelViewProjection(camera->getProjection() * Scene::calculateModelView(camera));
+
+    // World position is reconstructed from the depth, see Window::update()
+    Math::Mat4 inverseViewProjection(modelViewProjection);
+    inverseViewProjection.invert();
+
+    // Specialized program per light type, indexed by LightType
+    static const std::string lightTypes[] = { "LIGHT_TYPE=TYPE_POINT", "LIGHT_TYPE=TYPE_SPOT", "LIGHT_TYPE=TYPE_DIRECTED" };
+    struct {
+        std::shared_ptr<Shader> shader;
+        UniformHandle<Math::Vec3> lightPosition;
+        UniformHandle<Math::Vec3> lightDirection;
+    } lightPasses[3];
+
+    for (int lightType = 0; lightType < 3; lightType++) {
+        auto shader = selectPermutation(this->shader, { lightTypes[lightType] });
+
+        shader->setUniformBlock("Light", BIND_LIGHT);
+        shader->setUniform("diffuseSampler", TEXTURE_DIFFUSE);
+        shader->setUniform("specularSampler", TEXTURE_SPECULAR);
+        shader->setUniform("normalSampler", TEXTURE_NORMAL);
+        shader->setUniform("depthSampler", TEXTURE_DEPTH);
+        shader->setUniform("cameraPosition", Scene::calculatePosition(camera));
+        shader->setUniform("inverseViewProjection", inverseViewProjection);
+
+        lightPasses[lightType].shader = shader;
+        lightPasses[lightType].lightPosition = shader->getUniform<Math::Vec3>("lightPosition");
+        lightPasses[lightType].lightDirection = shader->getUniform<Math::Vec3>("lightDirection");
+    }
+
+    auto& renderStats = renderManager->getRenderStats();
+
+    // Limit every light to its on-screen footprint instead of shading the whole frame
+    GetGLStateCache().enable(GL_SCISSOR_TEST);
+
+    Frustum frustum(modelViewProjection);
+    renderStats.culledLights += scene->iterateLights(frustum, [this, &frame, viewport, &modelViewProjection, &renderStats, &lightPasses](const std::shared_ptr<Light>& light, const Math::Vec3& position, const Math::Vec3& direction) {
+        GLint scissor[4];
+        if (light->getLightType() == LightType::DIRECTED) {
+            std::copy(viewport, viewport + 4, scissor);
+        } else if (!calculateScissor(position, light->getRange(), modelViewProjection, viewport, scissor)) {
+            renderStats.culledLights++;  // Empty footprint
+            return;
+        }
+
+        renderStats.visibleLights++;
+
+        GetGLStateCache().scissor(scissor[0], scissor[1], scissor[2], scissor[3]);
+
+        auto& lightPass = lightPasses[light->getLightType()];
+        lightPass.shader->enable();
+        lightPass.lightPosition.set(position);
+        lightPass.lightDirection.set(direction);
+
+        this->activeShader = lightPass.shader;
+        this->callback(this, light);
+
+        light->bind(BIND_LIGHT);
+
+        frame->render();
+    });
+
+    GetGLStateCache().disable(GL_SCISSOR_TEST);
+    this->activeShader = this->shader;  // Releases the permutation
+
+    return RenderNone::ID;
+}
+
+RenderLightClusters::RenderLightClusters():
+        lightGrid(16, 9, 24) {
+    GLint offsetAlignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &offsetAlignment);
+    this->uniformAlignment = std::max(offsetAlignment, 1);
+
+    this->clustersTexture = std::make_shared<BufferTexture>(GL_RG32UI);
+    this->lightsTexture = std::make_shared<BufferTexture>(GL_R32UI);
+}
+
+MetaType RenderLightClusters::update(RenderManager* renderManager, const std::shared_ptr<Camera>& camera) {
+    auto scene = camera->getScene();
+    auto& frame = renderManager->getFrame();
+    Math::Mat4 modelView(Scene::calculateModelView(camera));
+    Math::Mat4 modelViewProjection(camera->getProjection() * modelView);
+
+    Math::Mat4 inverseViewProjection(modelViewProjection);
+    inverseViewProjection.invert();
+
+    auto& renderStats = renderManager->getRenderStats();
+
+    std::vector<ClusteredLight> lights;
+    std::vector<BoundingSphere> lightVolumes;
+
+    Frustum frustum(modelViewProjection);
+    renderStats.culledLights += scene->iterateLights(frustum, [this, &lights, &lightVolumes, &renderStats](const std::shared_ptr<Light>& light, const Math::Vec3& position, const Math::Vec3& direction) {
+        this->callback(this, light);
+        renderStats.visibleLights++;
+
+        ClusteredLight clusteredLight = { };
+        std::copy(position.data(), position.data() + 3, clusteredLight.position);
+        std::copy(direction.data(), direction.data() + 3, clusteredLight.direction);
+        std::copy(light->getColor().data(), light->getColor().data() + 3, clusteredLight.color);
+
+        clusteredLight.range = light->getRange();
+        clusteredLight.type = light->getLightType();
+        clusteredLight.energy = light->getEnergy();
+        clusteredLight.falloff = light->getFalloff();
+        clusteredLight.angle = light->getAngle();
+        clusteredLight.blend = light->getBlend();
+
+        lights.push_back(clusteredLight);
+        lightVolumes.emplace_back(position, clusteredLight.range);
+    });
+
+    this->shader->setUniformBlock("Lights", BIND_LIGHTS);
     this->shader->setUniform("diffuseSampler", TEXTURE_DIFFUSE);
     this->shader->setUniform("specularSampler", TEXTURE_SPECULAR);
-    this->shader->setUniform("positionSampler", TEXTURE_POSITION);
     this->shader->setUniform("normalSampler", TEXTURE_NORMAL);
+    this->shader->setUniform("depthSampler", TEXTURE_DEPTH);
+    this->shader->setUniform("clustersSampler", TEXTURE_CLUSTERS);
+    this->shader->setUniform("lightsSampler", TEXTURE_LIGHTS);
     this->shader->setUniform("cameraPosition", Scene::calculatePosition(camera));
+    this->shader->setUniform("modelView", modelView);
+    this->shader->setUniform("inverseViewProjection", inverseViewProjection);
+    this->shader->setUniform("clustersWidth", this->lightGrid.getWidth());
+    this->shader->setUniform("clustersHeight", this->lightGrid.getHeight());
+    this->shader->setUniform("clustersDepth", this->lightGrid.getDepth());
 
-    scene->iterateLights([this, &frame](const std::shared_ptr<Light>& light, const Math::Vec3& position, const Math::Vec3& direction) {
-        this->callback(this, light);
+    auto& lightsBuffer = renderManager->getDynamicUniformBuffer();
+    size_t lightsCount = lights.size();
 
-        this->shader->setUniform("lightPosition", position);
-        this->shader->setUniform("lightDirection", direction);
+    // Every batch binds a whole Lights block, pad the last one
+    size_t batches = (lightsCount + CLUSTERED_LIGHTS_MAX - 1) / CLUSTERED_LIGHTS_MAX;
+    lights.resize(batches * CLUSTERED_LIGHTS_MAX, ClusteredLight());
 
-        light->bind(BIND_LIGHT);
+    // Single pass per CLUSTERED_LIGHTS_MAX lights, passes are blended additively
+    for (size_t first = 0; first < lightsCount; first += CLUSTERED_LIGHTS_MAX) {
+        size_t count = std::min(lightsCount - first, static_cast<size_t>(CLUSTERED_LIGHTS_MAX));
+        std::vector<BoundingSphere> batchVolumes(lightVolumes.begin() + first, lightVolumes.begin() + first + count);
+
+        this->lightGrid.update(camera, modelView, batchVolumes);
+
+        auto& clusters = this->lightGrid.getCells();
+        auto& indices = this->lightGrid.getIndices();
+        unsigned int noIndices = 0;  // Buffer texture has to have storage
+
+        size_t lightsSize = sizeof(ClusteredLight) * CLUSTERED_LIGHTS_MAX;
+        size_t lightsOffset = lightsBuffer->write(&lights[first], lightsSize, this->uniformAlignment);
+        this->clustersTexture->update(clusters.data(), sizeof(unsigned int) * clusters.size());
+        this->lightsTexture->update(indices.empty() ? &noIndices : indices.data(),
+                sizeof(unsigned int) * std::max(indices.size(), static_cast<size_t>(1)));
+
+        GetGLStateCache().bindBufferRange(GL_UNIFORM_BUFFER, BIND_LIGHTS, lightsBuffer->getHandle(), lightsOffset, lightsSize);
+        this->clustersTexture->bind(TEXTURE_CLUSTERS);
+        this->lightsTexture->bind(TEXTURE_LIGHTS);
+
+        this->shader->setUniform("depthScale", this->lightGrid.getDepthScale());
+        this->shader->setUniform("depthBias", this->lightGrid.getDepthBias());
 
         frame->render();
-    });
+    }
 
     return RenderNone::ID;
 }
@@ -27,16 +27,27 @@
 #include <NonCopyable.h>
 #include <MetaObject.h>
 #include <Object.h>
+#include <Entity.h>
 #include <Camera.h>
 #include <Shader.h>
+#include <LightGrid.h>
+#include <OcclusionBuffer.h>
+#include <OcclusionQueries.h>
+#include <RenderQueue.h>
+#include <UniformBuffer.h>
+#include <Texture.h>
+#include <unordered_map>
 #include <memory>
 #include <functional>
+#include <vector>
 
 namespace Graphene {
 
 class RenderState;
 class RenderManager;
 
+// Called right before the object is drawn, culled objects are never passed. Geometry entities
+// with a callback set are drawn one by one, once per mesh, instead of being batched
 typedef std::function<void(RenderState* renderState, const std::shared_ptr<Object>)> RenderStateCallback;
 
 class RenderState: public NonCopyable {
@@ -45,6 +56,7 @@ public:
 
     GRAPHENE_API void setShader(const std::shared_ptr<Shader>& shader);
     GRAPHENE_API const std::shared_ptr<Shader>& getShader() const;
+    GRAPHENE_API const std::shared_ptr<Shader>& getActiveShader() const;  // Bound while the callback runs, may be a permutation
 
     GRAPHENE_API void setCallback(const RenderStateCallback& callback);
     GRAPHENE_API const RenderStateCallback& getCallback() const;
@@ -54,10 +66,39 @@ public:
 
 protected:
     std::shared_ptr<Shader> shader;
+    std::shared_ptr<Shader> activeShader;
     RenderStateCallback callback = [](RenderState* /*renderState*/, const std::shared_ptr<Object>& /*object*/) { };
+    bool callbackSet = false;
+};
+
+class RenderGeometry: public MetaObject<RenderGeometry>, public RenderState {
+public:
+    GRAPHENE_API MetaType update(RenderManager* renderManager, const std::shared_ptr<Camera>& camera) override;
+
+private:
+    typedef struct {
+        std::shared_ptr<Entity> entity;
+        Math::Mat4 localWorld;
+        Math::Mat4 normalRotation;
+    } OcclusionCandidate;
+
+    RenderQueue renderQueue;
+    RenderQueue depthQueue;
+
+    RenderQueue callbackQueue;  // Unsorted, drawn item by item
+    std::vector<std::shared_ptr<Entity>> callbackEntities;  // Per callback queue item
+
+    std::shared_ptr<OcclusionBuffer> occlusionBuffer;  // Created once occlusion culling is on
+    std::vector<OcclusionCandidate> occlusionCandidates;
+
+    typedef struct {
+        std::weak_ptr<Camera> camera;  // Queries of destroyed cameras are released
+        std::shared_ptr<OcclusionQueries> queries;
+    } CameraQueries;
+
+    std::unordered_map<int, CameraQueries> occlusionQueries;  // By camera id
 };
 
-class RenderGeometry: public MetaObject<RenderGeometry>, public RenderState { };
 class RenderOverlay: public MetaObject<RenderOverlay>, public RenderState { };
 class RenderBuffer: public MetaObject<RenderBuffer>, public RenderState { };
 
@@ -81,6 +122,20 @@ public:
     GRAPHENE_API MetaType update(RenderManager* renderManager, const std::shared_ptr<Camera>& camera) override;
 };
 
+class RenderLightClusters: public MetaObject<RenderLightClusters>, public RenderState {
+public:
+    GRAPHENE_API RenderLightClusters();
+
+    GRAPHENE_API MetaType update(RenderManager* renderManager, const std::shared_ptr<Camera>& camera) override;
+
+private:
+    LightGrid lightGrid;
+    size_t uniformAlignment = 0;
+
+    std::shared_ptr<BufferTexture> clustersTexture;
+    std::shared_ptr<BufferTexture> lightsTexture;
+};
+
 class RenderNone: public MetaObject<RenderNone>, public RenderState {
 public:
     GRAPHENE_API MetaType update(RenderManager* renderManager, const std::shared_ptr<Camera>& camera) override;
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <RenderTargetPool.h>
+#include <Logger.h>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Graphene {
+
+static size_t getPixelSize(GLenum format) {
+    switch (format) {
+        case GL_RGBA16:
+        case GL_RGBA16F:
+            return 8;
+
+        case GL_DEPTH_COMPONENT16:
+            return 2;
+
+        default:
+            return 4;  // RGBA8 and alike, DEPTH24 is padded to 32 bits
+    }
+}
+
+RenderTargetPool& RenderTargetPool::getInstance() {
+    static RenderTargetPool instance;
+    return instance;
+}
+
+std::shared_ptr<Texture2D> RenderTargetPool::acquireTexture(int width, int height, GLenum format) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument(LogFormat("Render target size is not positive"));
+    }
+
+    for (auto& entry: this->entries) {
+        if (!entry.acquired && entry.width == width && entry.height == height && entry.format == format) {
+            entry.acquired = true;
+            entry.idleFrames = 0;
+            return entry.texture;
+        }
+    }
+
+    LogDebug("Pooling %dx%d render target (format 0x%x)", width, height, format);
+
+    auto texture = std::make_shared<Texture2D>(width, height, format, 1);
+    this->entries.push_back({ texture, width, height, format, true, 0 });
+    return texture;
+}
+
+void RenderTargetPool::releaseTexture(const std::shared_ptr<Texture2D>& texture) {
+    auto entry = std::find_if(this->entries.begin(), this->entries.end(), [&texture](const PoolEntry& entry) {
+        return entry.texture == texture;
+    });
+
+    if (entry == this->entries.end() || !entry->acquired) {
+        throw std::invalid_argument(LogFormat("Render target is not acquired from the pool"));
+    }
+
+    entry->acquired = false;
+}
+
+size_t RenderTargetPool::getPooledMemory() const {
+    size_t pooledMemory = 0;
+
+    for (auto& entry: this->entries) {
+        pooledMemory += static_cast<size_t>(entry.width) * entry.height * getPixelSize(entry.format);
+    }
+
+    return pooledMemory;
+}
+
+int RenderTargetPool::getPooledTargets() const {
+    return static_cast<int>(this->entries.size());
+}
+
+void RenderTargetPool::update() {
+    for (auto& entry: this->entries) {
+        if (!entry.acquired) {
+            entry.idleFrames++;
+        }
+    }
+
+    this->entries.erase(std::remove_if(this->entries.begin(), this->entries.end(), [](const PoolEntry& entry) {
+        return !entry.acquired && entry.idleFrames > RENDER_TARGET_IDLE_FRAMES;
+    }), this->entries.end());
+}
+
+void RenderTargetPool::teardown() {
+    this->entries.clear();
+}
+
+}  // namespace Graphene
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef RENDERTARGETPOOL_H
+#define RENDERTARGETPOOL_H
+
+#include <GrapheneApi.h>
+#include <NonCopyable.h>
+#include <Texture.h>
+#include <OpenGL.h>
+#include <cstddef>
+#include <vector>
+#include <memory>
+
+#define GetRenderTargetPool() RenderTargetPool::getInstance()
+
+#define RENDER_TARGET_IDLE_FRAMES 120  // Released targets unused for longer are freed
+
+namespace Graphene {
+
+/*
+ * Transient textures shared by passes rendered one after another. A texture is handed out
+ * until released and then goes back to the pool for the next request of the same size and
+ * format, passes rendered in sequence end up on the same storage, see FrameGraph.
+ */
+class RenderTargetPool: public NonCopyable {
+public:
+    GRAPHENE_API static RenderTargetPool& getInstance();
+
+    GRAPHENE_API std::shared_ptr<Texture2D> acquireTexture(int width, int height, GLenum format);
+    GRAPHENE_API void releaseTexture(const std::shared_ptr<Texture2D>& texture);
+
+    GRAPHENE_API size_t getPooledMemory() const;  // Estimate in bytes, acquired and released
+    GRAPHENE_API int getPooledTargets() const;
+
+    GRAPHENE_API void update();  // Once per frame, frees idle targets
+    GRAPHENE_API void teardown();
+
+private:
+    RenderTargetPool() = default;
+
+    typedef struct {
+        std::shared_ptr<Texture2D> texture;
+        int width;
+        int height;
+        GLenum format;
+        bool acquired;
+        int idleFrames;
+    } PoolEntry;
+
+    std::vector<PoolEntry> entries;
+};
+
+}  // namespace Graphene
+
+#endif  // RENDERTARGETPOOL_H
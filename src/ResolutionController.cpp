@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <ResolutionController.h>
+#include <Logger.h>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+namespace Graphene {
+
+ResolutionController::ResolutionController(float targetFrameTime, float minScale, float maxScale):
+        targetFrameTime(targetFrameTime),
+        minScale(minScale),
+        maxScale(maxScale),
+        scale(maxScale) {
+    if (targetFrameTime <= 0.0f) {
+        throw std::invalid_argument(LogFormat("Target frame time is not positive"));
+    }
+
+    if (minScale <= 0.0f || minScale > maxScale || maxScale > 1.0f) {
+        throw std::invalid_argument(LogFormat("Resolution scale bounds are not within (0, 1]"));
+    }
+}
+
+void ResolutionController::update(float gpuFrameTime) {
+    if (this->settleFrames > 0) {
+        this->settleFrames--;
+        return;
+    }
+
+    float budget = this->targetFrameTime * RESOLUTION_GPU_HEADROOM;
+
+    if (gpuFrameTime > budget) {
+        // Frame time goes with the pixel count, that is the scale squared
+        this->framesUnderBudget = 0;
+        this->setScale(this->scale * std::sqrt(budget / gpuFrameTime));
+        return;
+    }
+
+    float raisedScale = this->scale + RESOLUTION_SCALE_STEP;
+    float predictedFrameTime = gpuFrameTime * (raisedScale * raisedScale) / (this->scale * this->scale);
+
+    if (this->scale >= this->maxScale || predictedFrameTime > budget * RESOLUTION_RAISE_MARGIN) {
+        this->framesUnderBudget = 0;
+        return;
+    }
+
+    if (++this->framesUnderBudget >= RESOLUTION_RAISE_FRAMES) {
+        this->framesUnderBudget = 0;
+        this->setScale(raisedScale);
+    }
+}
+
+float ResolutionController::getScale() const {
+    return this->scale;
+}
+
+float ResolutionController::getTargetFrameTime() const {
+    return this->targetFrameTime;
+}
+
+void ResolutionController::setScale(float scale) {
+    // Rounded down, a drop is never rounded back up to the same step
+    float steps = std::floor(scale / RESOLUTION_SCALE_STEP + 0.001f);
+    float snappedScale = std::min(std::max(steps * RESOLUTION_SCALE_STEP, this->minScale), this->maxScale);
+
+    if (snappedScale != this->scale) {
+        this->scale = snappedScale;
+        this->settleFrames = RESOLUTION_SETTLE_FRAMES;
+    }
+}
+
+}  // namespace Graphene
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef RESOLUTIONCONTROLLER_H
+#define RESOLUTIONCONTROLLER_H
+
+#include <GrapheneApi.h>
+
+#define RESOLUTION_SCALE_STEP    0.05f  // Scales snap to the step, pooled targets are reused
+#define RESOLUTION_GPU_HEADROOM  0.9f   // GPU time budget share of the target frame time
+#define RESOLUTION_RAISE_MARGIN  0.8f   // Raised only when the predicted time stays below the share of the budget
+#define RESOLUTION_RAISE_FRAMES  30     // Consecutive frames under the budget before a raise
+#define RESOLUTION_SETTLE_FRAMES 3      // Frames ignored after a change, queried timings lag behind
+
+namespace Graphene {
+
+/*
+ * Picks the resolution scale from the measured GPU frame time. Over the budget the scale
+ * drops right away by the pixel count ratio, under the budget it is raised one step at a
+ * time after a while. Frames are kept at the cost of resolution, never the other way round.
+ */
+class ResolutionController {
+public:
+    GRAPHENE_API ResolutionController(float targetFrameTime, float minScale, float maxScale);
+
+    GRAPHENE_API void update(float gpuFrameTime);  // Milliseconds, as late as the queries are
+
+    GRAPHENE_API float getScale() const;
+    GRAPHENE_API float getTargetFrameTime() const;
+
+private:
+    void setScale(float scale);
+
+    float targetFrameTime;
+    float minScale;
+    float maxScale;
+    float scale;
+
+    int framesUnderBudget = 0;
+    int settleFrames = 0;
+};
+
+}  // namespace Graphene
+
+#endif  // RESOLUTIONCONTROLLER_H
@@ -84,6 +84,8 @@ void Rotatable::rotate(const Math::Vec3& vector, float angle) {
     this->cameraRotation.set(2, 0, target.get(Math::Vec3::X));
     this->cameraRotation.set(2, 1, target.get(Math::Vec3::Y));
     this->cameraRotation.set(2, 2, target.get(Math::Vec3::Z));
+
+    this->invalidateTransformation();
 }
 
 Math::Vec3 Rotatable::getRight() const {
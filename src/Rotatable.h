@@ -47,6 +47,9 @@ public:
     GRAPHENE_API const Math::Mat4& getRotation() const;
     GRAPHENE_API const Math::Mat4& getCameraRotation() const;
 
+protected:
+    virtual void invalidateTransformation() { }
+
 private:
     Math::Vec3 rotationAngles;
     Math::Mat4 rotation;
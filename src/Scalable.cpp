@@ -54,6 +54,8 @@ void Scalable::scale(const Math::Vec3& factors) {
     this->scaling.set(0, 0, this->scaling.get(0, 0) * factorX);
     this->scaling.set(1, 1, this->scaling.get(1, 1) * factorY);
     this->scaling.set(2, 2, this->scaling.get(2, 2) * factorZ);
+
+    this->invalidateTransformation();
 }
 
 Math::Vec3 Scalable::getScalingFactors() const {
@@ -43,6 +43,9 @@ public:
     GRAPHENE_API Math::Vec3 getScalingFactors() const;
     GRAPHENE_API const Math::Mat4& getScaling() const;
 
+protected:
+    virtual void invalidateTransformation() { }
+
 private:
     Math::Mat4 scaling;
 };
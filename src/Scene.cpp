@@ -21,10 +21,12 @@
  */
 
 #include <Scene.h>
+#include <GraphicsComponent.h>
 #include <Logger.h>
 #include <Object.h>
 #include <Vec4.h>
 #include <algorithm>
+#include <limits>
 #include <stdexcept>
 #include <sstream>
 
@@ -97,95 +99,188 @@ float Scene::getAmbientEnergy() const {
 }
 
 Math::Mat4 Scene::calculateModelView(const std::shared_ptr<Camera>& camera) {
-    Math::Mat4 modelView;
-    camera->iterateParents([&modelView](const std::shared_ptr<ObjectGroup>& parent) {
-        modelView = parent->getCameraRotation() * parent->getCameraTranslation() * modelView;
-    });
+    Math::Vec3 position(camera->getWorldPosition());
+    Math::Mat4 cameraTranslation;
+    cameraTranslation.set(0, 3, -position.get(Math::Vec3::X));
+    cameraTranslation.set(1, 3, -position.get(Math::Vec3::Y));
+    cameraTranslation.set(2, 3, -position.get(Math::Vec3::Z));
 
-    // Moving to the root object group, current groups's transformation matrix is the left operand
-    // to be the last operation. Eventually root object group's transformation will be the last one.
-    return camera->getCameraRotation() * camera->getCameraTranslation() * modelView;
+    return Scene::calculateView(camera) * cameraTranslation;
 }
 
 Math::Mat4 Scene::calculateView(const std::shared_ptr<Camera>& camera) {
+    // Inverse of the orthonormal world rotation is its transpose
+    Math::Mat4 worldRotation(camera->getWorldRotation());
     Math::Mat4 view;
-    camera->iterateParents([&view](const std::shared_ptr<ObjectGroup>& parent) {
-        view = parent->getCameraRotation() * view;
-    });
 
-    // Moving to the root object group, current group's transformation matrix is the left operand
-    // to be the last operation. Eventually root object group's transformation will be the last one.
-    return camera->getCameraRotation() * view;
+    for (int row = 0; row < 3; row++) {
+        for (int column = 0; column < 3; column++) {
+            view.set(row, column, worldRotation.get(column, row));
+        }
+    }
+
+    return view;
 }
 
 Math::Vec3 Scene::calculatePosition(const std::shared_ptr<Camera>& camera) {
-    Math::Mat4 translation;
-    camera->iterateParents([&translation](const std::shared_ptr<ObjectGroup>& parent) {
-        translation = parent->getTranslation() * translation;
-    });
-
-    // Moving to the root object group, current group's transformation matrix is the left operand
-    // to be the last operation. Eventually root object group's transformation will be the last one.
-    translation = camera->getTranslation() * translation;
-    return Math::Vec3(translation.get(0, 3), translation.get(1, 3), translation.get(2, 3));
+    return camera->getWorldPosition();
 }
 
 void Scene::iterateEntities(const EntityHandler& handler) const {
-    std::function<void(const std::shared_ptr<ObjectGroup>, Math::Mat4, Math::Mat4)> traverser;
-    traverser = [&handler, &traverser](const std::shared_ptr<ObjectGroup>& objectGroup, Math::Mat4 localWorld, Math::Mat4 normalRotation) {
-        // Moving from the root object group, current group's transformation matrix is the right operand
-        // to be the first operation. Keep the root object groups's transformation the last one.
-        localWorld = localWorld * objectGroup->getTranslation() * objectGroup->getRotation() * objectGroup->getScaling();
-        normalRotation = normalRotation * objectGroup->getRotation();
-
+    std::function<void(const std::shared_ptr<ObjectGroup>)> traverser;
+    traverser = [&handler, &traverser](const std::shared_ptr<ObjectGroup>& objectGroup) {
         auto& objects = objectGroup->getObjects();
-        std::for_each(objects.begin(), objects.end(), [&handler, &traverser, &localWorld, &normalRotation](const std::shared_ptr<Object>& object) {
+        std::for_each(objects.begin(), objects.end(), [&handler, &traverser](const std::shared_ptr<Object>& object) {
             if (object->isA<Entity>()) {
                 auto entity = object->toA<Entity>();
                 if (entity->isVisible()) {
-                    Math::Mat4 entityModelView(localWorld * entity->getTranslation() * entity->getRotation() * entity->getScaling());
-                    Math::Mat4 entityNormalRotation(normalRotation * entity->getRotation());
+                    handler(entity, entity->getWorldTransformation(), entity->getWorldRotation());
+                }
+            } else if (object->isA<ObjectGroup>()) {
+                auto objectGroup = object->toA<ObjectGroup>();
+
+                traverser(objectGroup);
+            }
+        });
+    };
 
-                    handler(entity, entityModelView, entityNormalRotation);
+    traverser(this->root);
+}
+
+void Scene::iterateEntities(const Frustum& frustum, const EntityHandler& handler) const {
+    std::function<void(const std::shared_ptr<ObjectGroup>, bool)> traverser;
+    traverser = [&frustum, &handler, &traverser](const std::shared_ptr<ObjectGroup>& objectGroup, bool inside) {
+        auto& objects = objectGroup->getObjects();
+        std::for_each(objects.begin(), objects.end(), [&frustum, &handler, &traverser, inside](const std::shared_ptr<Object>& object) {
+            if (object->isA<Entity>()) {
+                auto entity = object->toA<Entity>();
+                if (!entity->isVisible()) {
+                    return;
+                }
+
+                // Entities without geometry have nothing to cull, pass them through
+                Math::Mat4 localWorld(entity->getWorldTransformation());
+                auto boundingBox = entity->getBoundingBox();
+
+                if (inside || boundingBox.isEmpty() || frustum.intersects(boundingBox.transform(localWorld))) {
+                    handler(entity, localWorld, entity->getWorldRotation());
                 }
             } else if (object->isA<ObjectGroup>()) {
                 auto objectGroup = object->toA<ObjectGroup>();
+                auto& boundingBox = objectGroup->getBoundingBox();
+
+                // Whole subtree is rejected or accepted by a single test of its bounds
+                bool groupInside = inside;
+                if (!inside && !boundingBox.isEmpty()) {
+                    auto worldBoundingBox = boundingBox.transform(objectGroup->getWorldTransformation());
+                    if (!frustum.intersects(worldBoundingBox)) {
+                        return;
+                    }
+
+                    groupInside = frustum.contains(worldBoundingBox);
+                }
 
-                traverser(objectGroup, localWorld, normalRotation);
+                traverser(objectGroup, groupInside);
             }
         });
     };
 
-    Math::Mat4 localWorld;
-    Math::Mat4 normalRotation;
-    traverser(this->root, localWorld, normalRotation);
+    traverser(this->root, false);
 }
 
 void Scene::iterateLights(const LightHandler& handler) const {
-    std::function<void(const std::shared_ptr<ObjectGroup>, Math::Mat4)> traverser;
-    traverser = [&handler, &traverser](const std::shared_ptr<ObjectGroup>& objectGroup, Math::Mat4 localWorld) {
-        // Moving from the root object group, current group's transformation matrix is the left operand
-        // to be the last operation. Keep the root object group's transformation the last one.
-        localWorld = localWorld * objectGroup->getTranslation() * objectGroup->getRotation();
-
+    std::function<void(const std::shared_ptr<ObjectGroup>)> traverser;
+    traverser = [&handler, &traverser](const std::shared_ptr<ObjectGroup>& objectGroup) {
         auto& objects = objectGroup->getObjects();
-        std::for_each(objects.begin(), objects.end(), [&handler, &traverser, &localWorld](const std::shared_ptr<Object>& object) {
+        std::for_each(objects.begin(), objects.end(), [&handler, &traverser, &objectGroup](const std::shared_ptr<Object>& object) {
             if (object->isA<Light>()) {
                 auto light = object->toA<Light>();
-                Math::Vec4 lightPosition(localWorld * Math::Vec4(light->getPosition(), 1.0f));
-                Math::Vec4 lightDirection(localWorld * Math::Vec4(light->getDirection(), 0.0f));  // Ignore translation
+                Math::Vec4 lightDirection(objectGroup->getWorldRotation() * Math::Vec4(light->getDirection(), 0.0f));
+
+                handler(light, light->getWorldPosition(), lightDirection.extractVec3());
+            } else if (object->isA<ObjectGroup>()) {
+                auto objectGroup = object->toA<ObjectGroup>();
+
+                traverser(objectGroup);
+            }
+        });
+    };
+
+    traverser(this->root);
+}
+
+int Scene::iterateLights(const Frustum& frustum, const LightHandler& handler) const {
+    int culledLights = 0;
+
+    this->iterateLights([&frustum, &handler, &culledLights](const std::shared_ptr<Light>& light, const Math::Vec3& position, const Math::Vec3& direction) {
+        // Directed lights have infinite bounds and always pass
+        if (!frustum.intersects(light->getBoundingSphere(position, direction))) {
+            culledLights++;
+            return;
+        }
+
+        handler(light, position, direction);
+    });
+
+    return culledLights;
+}
 
-                handler(light, lightPosition.extractVec3(), lightDirection.extractVec3());
+RaycastHit Scene::raycast(const Math::Vec3& origin, const Math::Vec3& direction, unsigned int layers) const {
+    RaycastHit hit = { nullptr, nullptr, std::numeric_limits<float>::infinity(), -1 };
+
+    Math::Vec3 rayDirection(direction);
+    rayDirection.normalize();
+
+    std::function<void(const std::shared_ptr<ObjectGroup>)> traverser;
+    traverser = [&origin, &rayDirection, layers, &hit, &traverser](const std::shared_ptr<ObjectGroup>& objectGroup) {
+        auto& objects = objectGroup->getObjects();
+        std::for_each(objects.begin(), objects.end(), [&origin, &rayDirection, layers, &hit, &traverser](const std::shared_ptr<Object>& object) {
+            if (object->isA<Entity>()) {
+                auto entity = object->toA<Entity>();
+                if (!entity->isVisible() || (entity->getLayers() & layers) == 0) {
+                    return;
+                }
+
+                Math::Mat4 localWorld(entity->getWorldTransformation());
+                if (!entity->getBoundingBox().transform(localWorld).intersects(origin, rayDirection, hit.distance)) {
+                    return;
+                }
+
+                // Affine transformation keeps the ray parameter, local hits are world distances
+                Math::Mat4 worldLocal(localWorld);
+                worldLocal.invert();
+                Math::Vec3 localOrigin(Math::Vec4(worldLocal * Math::Vec4(origin, 1.0f)).extractVec3());
+                Math::Vec3 localDirection(Math::Vec4(worldLocal * Math::Vec4(rayDirection, 0.0f)).extractVec3());
+
+                for (auto& component: entity->getComponents()) {
+                    if (!component->isA<GraphicsComponent>()) {
+                        continue;
+                    }
+
+                    for (auto& mesh: component->toA<GraphicsComponent>()->getMeshes()) {
+                        if (mesh->hasGeometry() && mesh->getMeshTree()->raycast(localOrigin, localDirection, hit.distance, hit.triangle)) {
+                            hit.entity = entity;
+                            hit.mesh = mesh;
+                        }
+                    }
+                }
             } else if (object->isA<ObjectGroup>()) {
                 auto objectGroup = object->toA<ObjectGroup>();
+                auto& boundingBox = objectGroup->getBoundingBox();
 
-                traverser(objectGroup, localWorld);
+                // Subtrees beyond the nearest hit so far are skipped whole
+                if (!boundingBox.isEmpty() &&
+                        !boundingBox.transform(objectGroup->getWorldTransformation()).intersects(origin, rayDirection, hit.distance)) {
+                    return;
+                }
+
+                traverser(objectGroup);
             }
         });
     };
 
-    Math::Mat4 localWorld;
-    traverser(this->root, localWorld);
+    traverser(this->root);
+    return hit;
 }
 
 void Scene::update(float deltaTime) const {
@@ -30,6 +30,8 @@
 #include <Object.h>
 #include <ObjectGroup.h>
 #include <Light.h>
+#include <Mesh.h>
+#include <Frustum.h>
 #include <Mat4.h>
 #include <Vec3.h>
 #include <functional>
@@ -41,6 +43,15 @@ namespace Graphene {
 typedef std::function<void(const std::shared_ptr<Entity>&, const Math::Mat4&, const Math::Mat4&)> EntityHandler;
 typedef std::function<void(const std::shared_ptr<Light>&, const Math::Vec3&, const Math::Vec3&)> LightHandler;
 
+#define RAYCAST_LAYERS_ALL 0xFFFFFFFFu
+
+typedef struct {
+    std::shared_ptr<Entity> entity;  // Null if nothing was hit
+    std::shared_ptr<Mesh> mesh;
+    float distance;  // Along the normalized direction
+    int triangle;  // Of the mesh indices, three per triangle
+} RaycastHit;
+
 class Scene: public std::enable_shared_from_this<Scene>, public NonCopyable {
 public:
     GRAPHENE_API Scene();
@@ -66,7 +77,12 @@ public:
     GRAPHENE_API static Math::Vec3 calculatePosition(const std::shared_ptr<Camera>& camera);
 
     GRAPHENE_API void iterateEntities(const EntityHandler& handler) const;
+    GRAPHENE_API void iterateEntities(const Frustum& frustum, const EntityHandler& handler) const;
     GRAPHENE_API void iterateLights(const LightHandler& handler) const;
+    GRAPHENE_API int iterateLights(const Frustum& frustum, const LightHandler& handler) const;  // Returns culled lights count
+
+    // Nearest visible entity triangle, CPU side, meshes without kept geometry are never hit
+    GRAPHENE_API RaycastHit raycast(const Math::Vec3& origin, const Math::Vec3& direction, unsigned int layers = RAYCAST_LAYERS_ALL) const;
 
     GRAPHENE_API void update(float deltaTime) const;
 
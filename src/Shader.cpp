@@ -22,76 +22,157 @@
 
 #include <Shader.h>
 #include <Logger.h>
+#include <EngineConfig.h>
+#include <GLStateCache.h>
 #include <stdexcept>
 #include <sstream>
 #include <fstream>
+#include <iomanip>
+#include <cstdint>
+#include <algorithm>
 #include <memory>
+#include <chrono>
+
+#define BINARY_MAGIC 0x47425052  // "GBPR"
+#define FENCE_TIMEOUT 1000000  // 1ms in nanoseconds
 
 namespace Graphene {
 
-GLuint Shader::activeProgram = 0;
+#pragma pack(push, 1)
+
+typedef struct {
+    uint32_t magic;
+    uint32_t format;
+    uint32_t length;
+    uint64_t key;
+} BinaryHeader;
+
+#pragma pack(pop)
+
+std::weak_ptr<ContextWorker> Shader::contextWorker;
+
+static void hashString(uint64_t& hash, const char* string) {
+    // See https://en.wikipedia.org/wiki/Fowler-Noll-Vo_hash_function#FNV-1a_hash
+    // Terminator is hashed too to keep the fields apart, "ab" + "c" != "a" + "bc"
+    const char* character = string;
+    do {
+        hash ^= static_cast<unsigned char>(*character);
+        hash *= 0x100000001b3ULL;
+    } while (*character++ != '\0');
+}
+
+static uint64_t calculateBinaryKey(const std::string& source, const std::string& defines, GLuint version) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+
+    hashString(hash, source.c_str());
+    hashString(hash, defines.c_str());
+    hashString(hash, std::to_string(version).c_str());
+    hashString(hash, reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+    hashString(hash, reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+    hashString(hash, reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+
+    return hash;
+}
 
-Shader::Shader(const std::string& shaderSource):
+Shader::Shader(const std::string& shaderSource, const std::vector<std::string>& defines):
         shaderSource(shaderSource) {
     std::ostringstream defaultName;
     defaultName << std::hex << "Shader (0x" << this << ")";
     this->shaderName = defaultName.str();
 
+    std::ostringstream shaderDefines;
+    for (auto& define: defines) {
+        std::string definition(define);
+        std::replace(definition.begin(), definition.end(), '=', ' ');
+        shaderDefines << "#define " << definition << "\n";
+    }
+
+    this->shaderDefines = shaderDefines.str();
+
     this->shaderTypes = {
         { "#define TYPE_VERTEX\n",   GL_VERTEX_SHADER },
         { "#define TYPE_FRAGMENT\n", GL_FRAGMENT_SHADER }
     };
 
     this->buildShader();
-    this->queryUniforms();
-    this->queryUniformBlocks();
+
+    // Driver or the context worker compiles in the background, results are collected once the program is complete
+    if (!this->building && !OpenGL::isExtensionSupported("GL_KHR_parallel_shader_compile")) {
+        this->finishShader();
+    }
 }
 
 Shader::~Shader() {
-    if (this->program != 0) {
-        glDeleteProgram(this->program);
+    if (this->pendingBuild.valid()) {
+        this->pendingBuild.wait();  // The task refers to this shader
     }
+
+    if (this->buildFence != nullptr) {
+        glDeleteSync(this->buildFence);
+    }
+
+    this->deleteShader();
+}
+
+const std::shared_ptr<Shader>& Shader::getPermutation(const std::vector<std::string>& defines) {
+    std::vector<std::string> sortedDefines(defines);
+    std::sort(sortedDefines.begin(), sortedDefines.end());
+
+    std::ostringstream permutationKey;
+    for (auto& define: sortedDefines) {
+        permutationKey << define << ";";
+    }
+
+    auto permutationIt = this->permutations.find(permutationKey.str());
+    if (permutationIt != this->permutations.end()) {
+        return permutationIt->second;
+    }
+
+    auto permutation = std::make_shared<Shader>(this->shaderSource, sortedDefines);
+    permutation->setName(this->shaderName + " [" + permutationKey.str() + "]");
+
+    return this->permutations.emplace(permutationKey.str(), permutation).first->second;
 }
 
 void Shader::setUniform(const std::string& name, const Math::Mat4& value) {
     GLint uniform = this->checkoutUniform(name);
     if (uniform > -1) {
-        glUniformMatrix4fv(uniform, 1, GL_TRUE, (GLfloat*)value.data());
+        Shader::uploadUniform(uniform, value);
     }
 }
 
 void Shader::setUniform(const std::string& name, const Math::Mat3& value) {
     GLint uniform = this->checkoutUniform(name);
     if (uniform > -1) {
-        glUniformMatrix3fv(uniform, 1, GL_TRUE, (GLfloat*)value.data());
+        Shader::uploadUniform(uniform, value);
     }
 }
 
 void Shader::setUniform(const std::string& name, const Math::Vec4& value) {
     GLint uniform = this->checkoutUniform(name);
     if (uniform > -1) {
-        glUniform4fv(uniform, 1, (GLfloat*)value.data());
+        Shader::uploadUniform(uniform, value);
     }
 }
 
 void Shader::setUniform(const std::string& name, const Math::Vec3& value) {
     GLint uniform = this->checkoutUniform(name);
     if (uniform > -1) {
-        glUniform3fv(uniform, 1, (GLfloat*)value.data());
+        Shader::uploadUniform(uniform, value);
     }
 }
 
 void Shader::setUniform(const std::string& name, float value) {
     GLint uniform = this->checkoutUniform(name);
     if (uniform > -1) {
-        glUniform1f(uniform, value);
+        Shader::uploadUniform(uniform, value);
     }
 }
 
 void Shader::setUniform(const std::string& name, int value) {
     GLint uniform = this->checkoutUniform(name);
     if (uniform > -1) {
-        glUniform1i(uniform, value);
+        Shader::uploadUniform(uniform, value);
     }
 }
 
@@ -118,11 +199,62 @@ void Shader::setName(const std::string& shaderName) {
     this->shaderName = shaderName;
 }
 
+bool Shader::isReady() {
+    if (this->ready) {
+        return true;
+    }
+
+    if (this->building) {
+        if (!this->collectBuild(false)) {
+            return false;
+        }
+    } else {
+        GLint completionStatus = GL_FALSE;
+        glGetProgramiv(this->program, GL_COMPLETION_STATUS_KHR, &completionStatus);
+
+        if (completionStatus == GL_FALSE) {
+            return false;
+        }
+    }
+
+    this->finishShader();
+    return true;
+}
+
 void Shader::enable() {
-    if (Shader::activeProgram != this->program) {
-        glUseProgram(this->program);
-        Shader::activeProgram = this->program;
+    if (!this->ready) {
+        if (this->building) {
+            this->collectBuild(true);
+        }
+
+        this->finishShader();
     }
+
+    GetGLStateCache().useProgram(this->program);
+}
+
+void Shader::uploadUniform(GLint uniform, const Math::Mat4& value) {
+    glUniformMatrix4fv(uniform, 1, GL_TRUE, (GLfloat*)value.data());
+}
+
+void Shader::uploadUniform(GLint uniform, const Math::Mat3& value) {
+    glUniformMatrix3fv(uniform, 1, GL_TRUE, (GLfloat*)value.data());
+}
+
+void Shader::uploadUniform(GLint uniform, const Math::Vec4& value) {
+    glUniform4fv(uniform, 1, (GLfloat*)value.data());
+}
+
+void Shader::uploadUniform(GLint uniform, const Math::Vec3& value) {
+    glUniform3fv(uniform, 1, (GLfloat*)value.data());
+}
+
+void Shader::uploadUniform(GLint uniform, float value) {
+    glUniform1f(uniform, value);
+}
+
+void Shader::uploadUniform(GLint uniform, int value) {
+    glUniform1i(uniform, value);
 }
 
 GLint Shader::checkoutUniform(const std::string& name) {
@@ -149,44 +281,157 @@ GLuint Shader::checkoutUniformBlock(const std::string& name) {
     return uniformBlockIt->second;
 }
 
+void Shader::setContextWorker(const std::shared_ptr<ContextWorker>& contextWorker) {
+    Shader::contextWorker = contextWorker;
+}
+
 void Shader::buildShader() {
-    std::vector<GLuint> shaders;
+    this->binaryPath = this->getBinaryPath();
+    if (!this->binaryPath.empty() && this->loadBinary(this->binaryPath)) {
+        this->binaryPath.clear();  // Nothing to save back
+        return;
+    }
 
     std::ostringstream version;
     version << "#version " << this->version << "\n";
 
+    std::vector<std::pair<std::string, GLenum>> sources;
     for (auto& shaderType: this->shaderTypes) {
         std::string modifiedSource(this->shaderSource);
         modifiedSource.replace(modifiedSource.find(TOKEN_VERSION), sizeof(TOKEN_VERSION), version.str());
-        modifiedSource.replace(modifiedSource.find(TOKEN_TYPE), sizeof(TOKEN_TYPE), shaderType.first);
+        modifiedSource.replace(modifiedSource.find(TOKEN_TYPE), sizeof(TOKEN_TYPE), shaderType.first + this->shaderDefines);
+
+        sources.emplace_back(modifiedSource, shaderType.second);
+    }
+
+    auto contextWorker = Shader::contextWorker.lock();
+    if (contextWorker == nullptr || OpenGL::isExtensionSupported("GL_KHR_parallel_shader_compile")) {
+        for (auto& source: sources) {
+            this->shaders.emplace_back(this->compile(source.first, source.second));
+        }
 
-        shaders.emplace_back(this->compile(modifiedSource, shaderType.second));
+        this->program = this->link(this->shaders);
+        return;
     }
 
-    this->program = this->link(shaders);
+    // Members written by the task are read back only once the future is ready
+    this->building = true;
+    this->pendingBuild = contextWorker->post([this, sources]() {
+        for (auto& source: sources) {
+            this->shaders.emplace_back(this->compile(source.first, source.second));
+        }
+
+        this->program = this->link(this->shaders);
+        this->buildFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glFlush();  // Otherwise the fence may never get signaled
+    });
 }
 
-GLuint Shader::compile(const std::string& source, GLenum type) {
-    GLuint shader = glCreateShader(type);
-    const char* sourceStrings = source.c_str();
+bool Shader::collectBuild(bool blocking) {
+    if (this->pendingBuild.valid()) {
+        if (!blocking && this->pendingBuild.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return false;
+        }
 
-    glShaderSource(shader, 1, &sourceStrings, nullptr);
-    glCompileShader(shader);
+        try {
+            this->pendingBuild.get();
+        } catch (const std::exception&) {
+            this->building = false;  // Worker has no context, nothing was built
+            throw;
+        }
+    }
+
+    // Shared objects are safe to use from this context once the worker commands are complete
+    if (this->buildFence != nullptr) {
+        GLenum waitStatus = glClientWaitSync(this->buildFence, 0, blocking ? FENCE_TIMEOUT : 0);
+        while (blocking && waitStatus == GL_TIMEOUT_EXPIRED) {
+            waitStatus = glClientWaitSync(this->buildFence, 0, FENCE_TIMEOUT);
+        }
+
+        if (waitStatus == GL_TIMEOUT_EXPIRED) {
+            return false;
+        }
+
+        if (waitStatus == GL_WAIT_FAILED) {
+            LogWarn("Shader '%s' build fence wait failed", this->shaderName.c_str());
+        }
 
-    GLint compileStatus;
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &compileStatus);
+        glDeleteSync(this->buildFence);
+        this->buildFence = nullptr;
+    }
+
+    this->building = false;
+    return true;
+}
+
+void Shader::finishShader() {
+    // Status queries wait for the compilation, they are deferred until the program is needed
+    for (auto& shader: this->shaders) {
+        GLint compileStatus;
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &compileStatus);
+
+        if (compileStatus == GL_FALSE) {
+            GLint infoLogLength;
+            glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &infoLogLength);
+
+            std::unique_ptr<GLchar[]> infoLog(new GLchar[infoLogLength]);
+            glGetShaderInfoLog(shader, infoLogLength, nullptr, infoLog.get());
+            this->deleteShader();
+
+            throw std::runtime_error(LogFormat("%s", infoLog.get()));
+        }
+    }
+
+    for (auto& shader: this->shaders) {
+        glDeleteShader(shader);  // Attached shaders live until the program is deleted
+    }
+
+    this->shaders.clear();
 
-    if (compileStatus == GL_FALSE) {
+    GLint linkStatus;
+    glGetProgramiv(this->program, GL_LINK_STATUS, &linkStatus);
+
+    if (linkStatus == GL_FALSE) {
         GLint infoLogLength;
-        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &infoLogLength);
+        glGetProgramiv(this->program, GL_INFO_LOG_LENGTH, &infoLogLength);
 
         std::unique_ptr<GLchar[]> infoLog(new GLchar[infoLogLength]);
-        glGetShaderInfoLog(shader, infoLogLength, nullptr, infoLog.get());
-        glDeleteShader(shader);
+        glGetProgramInfoLog(this->program, infoLogLength, nullptr, infoLog.get());
+        this->deleteShader();
 
         throw std::runtime_error(LogFormat("%s", infoLog.get()));
     }
 
+    if (!this->binaryPath.empty()) {
+        this->saveBinary(this->binaryPath);
+        this->binaryPath.clear();
+    }
+
+    this->queryUniforms();
+    this->queryUniformBlocks();
+    this->ready = true;
+}
+
+void Shader::deleteShader() {
+    for (auto& shader: this->shaders) {
+        glDeleteShader(shader);
+    }
+
+    this->shaders.clear();
+
+    if (this->program != 0) {
+        glDeleteProgram(this->program);
+        this->program = 0;
+    }
+}
+
+GLuint Shader::compile(const std::string& source, GLenum type) {
+    GLuint shader = glCreateShader(type);
+    const char* sourceStrings = source.c_str();
+
+    glShaderSource(shader, 1, &sourceStrings, nullptr);
+    glCompileShader(shader);
+
     return shader;
 }
 
@@ -195,26 +440,112 @@ GLuint Shader::link(const std::vector<GLuint>& shaders) {
 
     for (auto& shader: shaders) {
         glAttachShader(program, shader);
-        glDeleteShader(shader);
+    }
+
+    if (OpenGL::isExtensionSupported("GL_ARB_get_program_binary")) {
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     }
 
     glLinkProgram(program);
 
+    return program;
+}
+
+std::string Shader::getBinaryPath() const {
+    auto& cacheDirectory = GetEngineConfig().getShaderCacheDirectory();
+    if (cacheDirectory.empty() || !OpenGL::isExtensionSupported("GL_ARB_get_program_binary")) {
+        return std::string();
+    }
+
+    GLint binaryFormats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormats);
+    if (binaryFormats == 0) {
+        return std::string();
+    }
+
+    std::ostringstream binaryPath;
+    binaryPath << cacheDirectory << '/' << std::hex << std::setw(16) << std::setfill('0')
+               << calculateBinaryKey(this->shaderSource, this->shaderDefines, this->version) << ".bin";
+
+    return binaryPath.str();
+}
+
+bool Shader::loadBinary(const std::string& binaryPath) {
+    std::ifstream file(binaryPath, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    BinaryHeader header = { };
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+    if (!file || header.magic != BINARY_MAGIC || header.key != calculateBinaryKey(this->shaderSource, this->shaderDefines, this->version)) {
+        LogWarn("Shader '%s' has invalid program binary '%s'", this->shaderName.c_str(), binaryPath.c_str());
+        return false;
+    }
+
+    // Length comes from the file, check it against what is actually there before allocating
+    std::streampos binaryOffset = file.tellg();
+    file.seekg(0, std::ios::end);
+    std::streamoff remainingLength = file.tellg() - binaryOffset;
+    file.seekg(binaryOffset);
+
+    if (!file || header.length == 0 || static_cast<std::streamoff>(header.length) != remainingLength) {
+        LogWarn("Shader '%s' program binary '%s' length does not match the file", this->shaderName.c_str(), binaryPath.c_str());
+        return false;
+    }
+
+    std::unique_ptr<char[]> binary(new char[header.length]);
+    file.read(binary.get(), header.length);
+
+    if (!file) {
+        LogWarn("Shader '%s' has truncated program binary '%s'", this->shaderName.c_str(), binaryPath.c_str());
+        return false;
+    }
+
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, header.format, binary.get(), header.length);
+
+    // Driver rejects binaries it cannot use (e.g. after an update), rebuild from the source
     GLint linkStatus;
     glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
 
     if (linkStatus == GL_FALSE) {
-        GLint infoLogLength;
-        glGetProgramiv(program, GL_INFO_LOG_LENGTH, &infoLogLength);
-
-        std::unique_ptr<GLchar[]> infoLog(new GLchar[infoLogLength]);
-        glGetProgramInfoLog(program, infoLogLength, nullptr, infoLog.get());
+        LogWarn("Shader '%s' program binary '%s' was rejected", this->shaderName.c_str(), binaryPath.c_str());
         glDeleteProgram(program);
+        return false;
+    }
 
-        throw std::runtime_error(LogFormat("%s", infoLog.get()));
+    LogDebug("Shader '%s' loaded from '%s'", this->shaderName.c_str(), binaryPath.c_str());
+    this->program = program;
+
+    return true;
+}
+
+void Shader::saveBinary(const std::string& binaryPath) {
+    GLint binaryLength = 0;
+    glGetProgramiv(this->program, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+    if (binaryLength <= 0) {
+        return;
     }
 
-    return program;
+    std::unique_ptr<char[]> binary(new char[binaryLength]);
+    GLenum binaryFormat = 0;
+    glGetProgramBinary(this->program, binaryLength, nullptr, &binaryFormat, binary.get());
+
+    BinaryHeader header = { };
+    header.magic = BINARY_MAGIC;
+    header.format = binaryFormat;
+    header.length = static_cast<uint32_t>(binaryLength);
+    header.key = calculateBinaryKey(this->shaderSource, this->shaderDefines, this->version);
+
+    std::ofstream file(binaryPath, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(binary.get(), binaryLength);
+
+    if (!file) {
+        LogWarn("Shader '%s' failed to write program binary '%s'", this->shaderName.c_str(), binaryPath.c_str());
+    }
 }
 
 void Shader::queryUniforms() {
@@ -26,6 +26,7 @@
 #include <GrapheneApi.h>
 #include <NonCopyable.h>
 #include <OpenGL.h>
+#include <ContextWorker.h>
 #include <Mat4.h>
 #include <Mat3.h>
 #include <Vec4.h>
@@ -33,17 +34,52 @@
 #include <unordered_map>
 #include <string>
 #include <vector>
+#include <memory>
+#include <future>
 
 #define TOKEN_VERSION "{SHADER_VERSION}"
 #define TOKEN_TYPE    "{SHADER_TYPE}"
 
 namespace Graphene {
 
+class Shader;
+
+/*
+ * Uniform location resolved once by Shader::getUniform(), setting a value through it skips
+ * the name lookup. A handle is bound to its shader and is invalidated with it.
+ */
+template<typename T>
+class UniformHandle {
+public:
+    UniformHandle() = default;  // Invalid, setting it is a no-op
+    UniformHandle(Shader* shader, GLint location):
+            shader(shader),
+            location(location) {
+    }
+
+    bool isValid() const {
+        return this->location > -1;
+    }
+
+    GLint getLocation() const {
+        return this->location;
+    }
+
+    void set(const T& value) const;
+
+private:
+    Shader* shader = nullptr;
+    GLint location = -1;
+};
+
 class Shader: public NonCopyable {
 public:
-    GRAPHENE_API Shader(const std::string& shaderSource);
+    GRAPHENE_API Shader(const std::string& shaderSource, const std::vector<std::string>& defines = { });
     GRAPHENE_API ~Shader();
 
+    // Variant of the same source built with extra "KEY" or "KEY=VALUE" defines, cached per set
+    GRAPHENE_API const std::shared_ptr<Shader>& getPermutation(const std::vector<std::string>& defines);
+
     GRAPHENE_API void setUniform(const std::string& name, const Math::Mat4& value);
     GRAPHENE_API void setUniform(const std::string& name, const Math::Mat3& value);
     GRAPHENE_API void setUniform(const std::string& name, const Math::Vec4& value);
@@ -52,37 +88,80 @@ public:
     GRAPHENE_API void setUniform(const std::string& name, int value);
     GRAPHENE_API void setUniformBlock(const std::string& name, int bindPoint);
 
+    template<typename T>
+    UniformHandle<T> getUniform(const std::string& name) {
+        return UniformHandle<T>(this, this->checkoutUniform(name));
+    }
+
     GRAPHENE_API GLuint getVersion() const;
     GRAPHENE_API const std::string& getSource() const;
 
     GRAPHENE_API const std::string& getName() const;
     GRAPHENE_API void setName(const std::string& shaderName);
 
-    GRAPHENE_API void enable();
+    GRAPHENE_API bool isReady();  // Polls background compilation, never blocks
+    GRAPHENE_API void enable();  // Blocks until the program is built
+
+    // Builds shaders off the rendering thread if the driver cannot, held weakly by the shaders
+    GRAPHENE_API static void setContextWorker(const std::shared_ptr<ContextWorker>& contextWorker);
 
 private:
+    template<typename T> friend class UniformHandle;
+
+    GRAPHENE_API static void uploadUniform(GLint uniform, const Math::Mat4& value);
+    GRAPHENE_API static void uploadUniform(GLint uniform, const Math::Mat3& value);
+    GRAPHENE_API static void uploadUniform(GLint uniform, const Math::Vec4& value);
+    GRAPHENE_API static void uploadUniform(GLint uniform, const Math::Vec3& value);
+    GRAPHENE_API static void uploadUniform(GLint uniform, float value);
+    GRAPHENE_API static void uploadUniform(GLint uniform, int value);
+
     GLint checkoutUniform(const std::string& name);
     GLuint checkoutUniformBlock(const std::string& name);
 
     void buildShader();
+    bool collectBuild(bool blocking);  // Worker build, false if still pending
+    void finishShader();
+    void deleteShader();
     GLuint compile(const std::string& source, GLenum type);
     GLuint link(const std::vector<GLuint>& shaders);
 
+    std::string getBinaryPath() const;  // Empty if program binary cache is unavailable
+    bool loadBinary(const std::string& binaryPath);
+    void saveBinary(const std::string& binaryPath);
+
     void queryUniforms();
     void queryUniformBlocks();
 
     std::unordered_map<std::string, GLint> uniforms;
     std::unordered_map<std::string, GLuint> uniformBlocks;
     std::unordered_map<std::string, GLenum> shaderTypes;
+    std::unordered_map<std::string, std::shared_ptr<Shader>> permutations;
 
     GLuint program = 0;
-    static GLuint activeProgram;
+
+    std::vector<GLuint> shaders;  // Pending compilation
+    std::string binaryPath;
+    bool ready = false;
+
+    static std::weak_ptr<ContextWorker> contextWorker;
+    std::future<void> pendingBuild;  // Issued on the context worker
+    GLsync buildFence = nullptr;  // Placed by the context worker after linking
+    bool building = false;
 
     GLuint version = 330;
     std::string shaderSource;
+    std::string shaderDefines;  // Preprocessed "#define" lines of a permutation
     std::string shaderName;
 };
 
+template<typename T>
+void UniformHandle<T>::set(const T& value) const {
+    if (this->location > -1) {
+        this->shader->enable();
+        Shader::uploadUniform(this->location, value);
+    }
+}
+
 }  // namespace Graphene
 
 #endif  // SHADER_H
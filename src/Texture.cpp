@@ -21,12 +21,10 @@
  */
 
 #include <Texture.h>
+#include <GLStateCache.h>
 
 namespace Graphene {
 
-TextureUnit Texture::activeUnit = TEXTURE_DIFFUSE;
-GLuint Texture::activeTexture = 0;
-
 Texture::Texture(int width, int height, GLenum type, GLenum format, GLsizei mipmaps):
         width(width),
         height(height),
@@ -37,8 +35,13 @@ Texture::Texture(int width, int height, GLenum type, GLenum format, GLsizei mipm
     glTexStorage2D(this->target, mipmaps, format, this->width, this->height);
 }
 
+Texture::Texture(GLenum type):
+        target(type) {
+    glGenTextures(1, &this->texture);
+}
+
 Texture::~Texture() {
-    glDeleteTextures(1, &this->texture);
+    GetGLStateCache().deleteTexture(this->texture);
 }
 
 int Texture::getWidth() const {
@@ -58,15 +61,26 @@ void Texture::bind() {
 }
 
 void Texture::bind(TextureUnit textureUnit) {
-    if (Texture::activeUnit != textureUnit) {
-        glActiveTexture(GL_TEXTURE0 + textureUnit);
-        Texture::activeUnit = textureUnit;
-    }
-
-    if (Texture::activeTexture != this->texture) {
-        glBindTexture(this->target, this->texture);
-        Texture::activeTexture = this->texture;
-    }
+    GetGLStateCache().bindTexture(textureUnit, this->target, this->texture);
+}
+
+BufferTexture::BufferTexture(GLenum format):
+        Texture(GL_TEXTURE_BUFFER) {
+    glGenBuffers(1, &this->buffer);
+    GetGLStateCache().bindBuffer(GL_TEXTURE_BUFFER, this->buffer);
+
+    this->bind();
+    glTexBuffer(GL_TEXTURE_BUFFER, format, this->buffer);
+}
+
+BufferTexture::~BufferTexture() {
+    GetGLStateCache().deleteBuffer(this->buffer);
+}
+
+void BufferTexture::update(const void* data, size_t dataSize) {
+    // Texture keeps referencing the buffer, reallocated storage is picked up as well
+    GetGLStateCache().bindBuffer(GL_TEXTURE_BUFFER, this->buffer);
+    glBufferData(GL_TEXTURE_BUFFER, dataSize, data, GL_STREAM_DRAW);
 }
 
 }  // namespace Graphene
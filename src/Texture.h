@@ -26,15 +26,17 @@
 #include <GrapheneApi.h>
 #include <NonCopyable.h>
 #include <OpenGL.h>
+#include <cstddef>
 
 namespace Graphene {
 
 enum TextureUnit {
     TEXTURE_DIFFUSE,   // GL_TEXTURE0
     TEXTURE_SPECULAR,  // GL_TEXTURE1
-    TEXTURE_POSITION,  // GL_TEXTURE2
-    TEXTURE_NORMAL,    // GL_TEXTURE3
-    TEXTURE_DEPTH      // GL_TEXTURE4
+    TEXTURE_NORMAL,    // GL_TEXTURE2
+    TEXTURE_DEPTH,     // GL_TEXTURE3
+    TEXTURE_CLUSTERS,  // GL_TEXTURE4
+    TEXTURE_LIGHTS     // GL_TEXTURE5
 };
 
 class Texture: public NonCopyable {
@@ -50,14 +52,13 @@ public:
     GRAPHENE_API void bind(TextureUnit textureUnit);
 
 protected:
+    Texture(GLenum type);  // No storage allocated
+
     int width = 0;
     int height = 0;
 
     GLenum target = 0;
     GLuint texture = 0;
-
-    static TextureUnit activeUnit;
-    static GLuint activeTexture;
 };
 
 class Texture2D: public Texture {
@@ -74,6 +75,17 @@ public:
     }
 };
 
+class BufferTexture: public Texture {
+public:
+    GRAPHENE_API BufferTexture(GLenum format);
+    GRAPHENE_API ~BufferTexture();
+
+    GRAPHENE_API void update(const void* data, size_t dataSize);
+
+private:
+    GLuint buffer = 0;
+};
+
 template<GLenum format, GLsizei mipmaps>
 class Texture2DTemplate: public Texture2D {
 public:
@@ -90,8 +102,7 @@ public:
     }
 };
 
-typedef Texture2DTemplate<GL_RGBA16F, 1>           GeometryTexture;
-typedef Texture2DTemplate<GL_DEPTH_COMPONENT16, 1> DepthTexture;
+typedef Texture2DTemplate<GL_DEPTH_COMPONENT24, 1> DepthTexture;
 typedef Texture2DTemplate<GL_SRGB8_ALPHA8, 4>      RgbaTexture;
 typedef TextureCubeMapTemplate<GL_SRGB8_ALPHA8, 4> RgbaCubeTexture;
 
@@ -0,0 +1,380 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <TransformStore.h>
+#include <Logger.h>
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define TRANSFORMSTORE_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace Graphene {
+
+TransformStore& TransformStore::getInstance() {
+    static TransformStore instance;
+    return instance;
+}
+
+int TransformStore::createNode() {
+    int handle;
+    if (!this->freeHandles.empty()) {
+        handle = this->freeHandles.back();
+        this->freeHandles.pop_back();
+    } else {
+        handle = static_cast<int>(this->indices.size());
+        this->indices.push_back(-1);
+    }
+
+    static const Matrix identity = {{
+        1.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 1.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, 1.0f, 0.0f,
+        0.0f, 0.0f, 0.0f, 1.0f
+    }};
+
+    // New nodes have no parent and are appended, which keeps the parent-first order intact
+    this->indices[handle] = static_cast<int>(this->handles.size());
+    this->localTransformations.push_back(identity);
+    this->localRotations.push_back(identity);
+    this->worldTransformations.push_back(identity);
+    this->worldRotations.push_back(identity);
+    this->parents.push_back(-1);
+    this->handles.push_back(handle);
+    this->dirty.push_back(0);
+    this->resolvedStamps.push_back(this->changesStamp);
+
+    return handle;
+}
+
+void TransformStore::destroyNode(int handle) {
+    int index = this->getIndex(handle);
+
+    // Leave a tombstone, the node is dropped with the next sort. Children of the
+    // destroyed node turn into root nodes during the next update.
+    this->parents[index] = -1;
+    this->handles[index] = -1;
+    this->dirty[index] = 0;
+
+    this->indices[handle] = -1;
+    this->freeHandles.push_back(handle);
+
+    this->destroyedNodes++;
+    this->nodesDirty = true;
+    this->changesStamp++;
+}
+
+void TransformStore::setParent(int handle, int parentHandle) {
+    int index = this->getIndex(handle);
+    int parentIndex = (parentHandle < 0) ? -1 : this->getIndex(parentHandle);
+
+    if (parentIndex > index) {
+        this->nodesUnsorted = true;
+    }
+
+    this->parents[index] = parentIndex;
+    this->dirty[index] = 1;
+    this->nodesDirty = true;
+    this->changesStamp++;
+}
+
+void TransformStore::setLocalTransformation(int handle, const Math::Mat4& transformation, const Math::Mat4& rotation) {
+    int index = this->getIndex(handle);
+
+    TransformStore::copy(transformation, this->localTransformations[index]);
+    TransformStore::copy(rotation, this->localRotations[index]);
+
+    this->dirty[index] = 1;
+    this->nodesDirty = true;
+    this->changesStamp++;
+}
+
+Math::Mat4 TransformStore::getWorldTransformation(int handle) {
+    return TransformStore::copy(this->worldTransformations[this->resolveNode(handle)]);
+}
+
+Math::Mat4 TransformStore::getWorldRotation(int handle) {
+    return TransformStore::copy(this->worldRotations[this->resolveNode(handle)]);
+}
+
+Math::Vec3 TransformStore::getWorldPosition(int handle) {
+    const float* transformation = this->worldTransformations[this->resolveNode(handle)].data;
+    return Math::Vec3(transformation[3], transformation[7], transformation[11]);
+}
+
+int TransformStore::getNodesCount() const {
+    return static_cast<int>(this->handles.size()) - this->destroyedNodes;
+}
+
+void TransformStore::update() {
+    if (!this->nodesDirty) {
+        return;
+    }
+
+    if (this->nodesUnsorted || this->destroyedNodes > this->getNodesCount()) {
+        this->sortNodes();
+    }
+
+    // Parents precede children, by the time a node is visited its parent is up to date
+    // and its dirty flag tells whether the node inherits the change.
+    int nodesCount = static_cast<int>(this->handles.size());
+    for (int index = 0; index < nodesCount; index++) {
+        if (this->handles[index] < 0) {
+            continue;
+        }
+
+        int parentIndex = this->parents[index];
+        if (parentIndex >= 0 && this->handles[parentIndex] < 0) {
+            parentIndex = this->parents[index] = -1;
+            this->dirty[index] = 1;
+        }
+
+        if (parentIndex < 0) {
+            if (this->dirty[index]) {
+                this->worldTransformations[index] = this->localTransformations[index];
+                this->worldRotations[index] = this->localRotations[index];
+            }
+
+            continue;
+        }
+
+        if (this->dirty[parentIndex]) {
+            this->dirty[index] = 1;
+        }
+
+        if (this->dirty[index]) {
+            // Parent's transformation matrix is the left operand to be the last operation
+            TransformStore::multiply(this->worldTransformations[parentIndex], this->localTransformations[index],
+                    this->worldTransformations[index]);
+            TransformStore::multiply(this->worldRotations[parentIndex], this->localRotations[index],
+                    this->worldRotations[index]);
+        }
+    }
+
+    std::fill(this->dirty.begin(), this->dirty.end(), 0);
+    this->nodesDirty = false;
+}
+
+int TransformStore::getIndex(int handle) const {
+    if (handle < 0 || handle >= static_cast<int>(this->indices.size()) || this->indices[handle] < 0) {
+        throw std::invalid_argument(LogFormat("Invalid transform node handle %d", handle));
+    }
+
+    return this->indices[handle];
+}
+
+int TransformStore::resolveNode(int handle) {
+    int index = this->getIndex(handle);
+    if (!this->nodesDirty || this->resolvedStamps[index] == this->changesStamp) {
+        return index;
+    }
+
+    if (this->nodesUnsorted) {
+        this->update();  // Parent chain may still loop, the sort finds out
+        return this->getIndex(handle);
+    }
+
+    // Walk up to the root, the chain is recalculated downwards from its highest changed node.
+    // Dirty flags are left for the pass, the subtrees of the changed nodes still need it
+    this->chain.clear();
+    int changedPosition = -1;
+
+    for (int node = index; node >= 0; ) {
+        int parentIndex = this->parents[node];
+        bool orphaned = (parentIndex >= 0 && this->handles[parentIndex] < 0);
+
+        if (this->dirty[node] || orphaned) {
+            changedPosition = static_cast<int>(this->chain.size());
+        }
+
+        this->chain.push_back(node);
+        node = orphaned ? -1 : parentIndex;
+    }
+
+    for (int position = changedPosition; position >= 0; position--) {
+        int node = this->chain[position];
+        int chainSize = static_cast<int>(this->chain.size());
+
+        if (position + 1 == chainSize) {
+            this->worldTransformations[node] = this->localTransformations[node];
+            this->worldRotations[node] = this->localRotations[node];
+        } else {
+            int parentIndex = this->chain[position + 1];
+            TransformStore::multiply(this->worldTransformations[parentIndex], this->localTransformations[node],
+                    this->worldTransformations[node]);
+            TransformStore::multiply(this->worldRotations[parentIndex], this->localRotations[node],
+                    this->worldRotations[node]);
+        }
+
+        this->resolvedStamps[node] = this->changesStamp;
+    }
+
+    this->resolvedStamps[index] = this->changesStamp;
+    return index;
+}
+
+void TransformStore::sortNodes() {
+    int nodesCount = static_cast<int>(this->handles.size());
+
+    // Children of every node, laid out contiguously: children of node i are in
+    // children[offsets[i]] .. children[offsets[i + 1] - 1]
+    std::vector<int> offsets(nodesCount + 1, 0);
+    for (int index = 0; index < nodesCount; index++) {
+        int parentIndex = this->parents[index];
+        if (this->handles[index] >= 0 && parentIndex >= 0 && this->handles[parentIndex] >= 0) {
+            offsets[parentIndex + 1]++;
+        }
+    }
+
+    for (int index = 0; index < nodesCount; index++) {
+        offsets[index + 1] += offsets[index];
+    }
+
+    std::vector<int> children(offsets[nodesCount]);
+    std::vector<int> position(offsets.begin(), offsets.end() - 1);
+    std::vector<int> order;
+    order.reserve(this->getNodesCount());
+
+    for (int index = 0; index < nodesCount; index++) {
+        if (this->handles[index] < 0) {
+            continue;
+        }
+
+        int parentIndex = this->parents[index];
+        if (parentIndex >= 0 && this->handles[parentIndex] >= 0) {
+            children[position[parentIndex]++] = index;
+        } else {
+            order.push_back(index);
+        }
+    }
+
+    // Breadth-first walk from the root nodes, every level follows the previous one
+    for (size_t head = 0; head < order.size(); head++) {
+        int index = order[head];
+        order.insert(order.end(), children.begin() + offsets[index], children.begin() + offsets[index + 1]);
+    }
+
+    if (static_cast<int>(order.size()) != this->getNodesCount()) {
+        throw std::runtime_error(LogFormat("Transform hierarchy contains a cycle"));
+    }
+
+    std::vector<int> newIndices(nodesCount, -1);
+    for (size_t newIndex = 0; newIndex < order.size(); newIndex++) {
+        newIndices[order[newIndex]] = static_cast<int>(newIndex);
+    }
+
+    std::vector<Matrix> localTransformations(order.size());
+    std::vector<Matrix> localRotations(order.size());
+    std::vector<Matrix> worldTransformations(order.size());
+    std::vector<Matrix> worldRotations(order.size());
+    std::vector<int> parents(order.size());
+    std::vector<int> handles(order.size());
+    std::vector<char> dirty(order.size());
+    std::vector<unsigned int> resolvedStamps(order.size());
+
+    for (size_t newIndex = 0; newIndex < order.size(); newIndex++) {
+        int index = order[newIndex];
+        int parentIndex = this->parents[index];
+
+        localTransformations[newIndex] = this->localTransformations[index];
+        localRotations[newIndex] = this->localRotations[index];
+        worldTransformations[newIndex] = this->worldTransformations[index];
+        worldRotations[newIndex] = this->worldRotations[index];
+        handles[newIndex] = this->handles[index];
+        dirty[newIndex] = this->dirty[index];
+        resolvedStamps[newIndex] = this->resolvedStamps[index];
+
+        if (parentIndex >= 0 && this->handles[parentIndex] < 0) {
+            parents[newIndex] = -1;  // Parent was destroyed
+            dirty[newIndex] = 1;
+        } else {
+            parents[newIndex] = (parentIndex < 0) ? -1 : newIndices[parentIndex];
+        }
+
+        this->indices[handles[newIndex]] = static_cast<int>(newIndex);
+    }
+
+    this->localTransformations.swap(localTransformations);
+    this->localRotations.swap(localRotations);
+    this->worldTransformations.swap(worldTransformations);
+    this->worldRotations.swap(worldRotations);
+    this->parents.swap(parents);
+    this->handles.swap(handles);
+    this->dirty.swap(dirty);
+    this->resolvedStamps.swap(resolvedStamps);
+
+    this->destroyedNodes = 0;
+    this->nodesUnsorted = false;
+}
+
+void TransformStore::multiply(const Matrix& a, const Matrix& b, Matrix& result) {
+#if defined(TRANSFORMSTORE_SSE)
+    // Row i of the result is a linear combination of the rows of b weighted by row i of a
+    // Unaligned access, std::vector storage is not over-aligned before C++17
+    __m128 row0 = _mm_loadu_ps(b.data + 0);
+    __m128 row1 = _mm_loadu_ps(b.data + 4);
+    __m128 row2 = _mm_loadu_ps(b.data + 8);
+    __m128 row3 = _mm_loadu_ps(b.data + 12);
+
+    for (int row = 0; row < 4; row++) {
+        const float* weights = a.data + row * 4;
+
+        __m128 sum = _mm_mul_ps(_mm_set1_ps(weights[0]), row0);
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[1]), row1));
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[2]), row2));
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[3]), row3));
+
+        _mm_storeu_ps(result.data + row * 4, sum);
+    }
+#else
+    for (int row = 0; row < 4; row++) {
+        for (int column = 0; column < 4; column++) {
+            result.data[row * 4 + column] =
+                    a.data[row * 4 + 0] * b.data[0 * 4 + column] +
+                    a.data[row * 4 + 1] * b.data[1 * 4 + column] +
+                    a.data[row * 4 + 2] * b.data[2 * 4 + column] +
+                    a.data[row * 4 + 3] * b.data[3 * 4 + column];
+        }
+    }
+#endif
+}
+
+void TransformStore::copy(const Math::Mat4& source, Matrix& destination) {
+    const float* data = source.data();
+    std::copy(data, data + 16, destination.data);
+}
+
+Math::Mat4 TransformStore::copy(const Matrix& source) {
+    Math::Mat4 destination;
+
+    for (int row = 0; row < 4; row++) {
+        for (int column = 0; column < 4; column++) {
+            destination.set(row, column, source.data[row * 4 + column]);
+        }
+    }
+
+    return destination;
+}
+
+}  // namespace Graphene
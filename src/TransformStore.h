@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef TRANSFORMSTORE_H
+#define TRANSFORMSTORE_H
+
+#include <GrapheneApi.h>
+#include <NonCopyable.h>
+#include <Mat4.h>
+#include <Vec3.h>
+#include <vector>
+
+#define GetTransformStore() TransformStore::getInstance()
+
+namespace Graphene {
+
+/*
+ * Transformations of all scene objects live here in flat arrays, one entry per node. Nodes are kept
+ * sorted so that every parent precedes its children and world matrices are recalculated with a single
+ * linear pass. Objects refer to their node with a handle which stays valid while nodes are reordered.
+ * Reads between passes resolve the queried node's ancestor chain only.
+ */
+class TransformStore: public NonCopyable {
+public:
+    GRAPHENE_API static TransformStore& getInstance();
+
+    GRAPHENE_API int createNode();
+    GRAPHENE_API void destroyNode(int handle);
+
+    GRAPHENE_API void setParent(int handle, int parentHandle);
+    GRAPHENE_API void setLocalTransformation(int handle, const Math::Mat4& transformation, const Math::Mat4& rotation);
+
+    GRAPHENE_API Math::Mat4 getWorldTransformation(int handle);
+    GRAPHENE_API Math::Mat4 getWorldRotation(int handle);
+    GRAPHENE_API Math::Vec3 getWorldPosition(int handle);
+
+    GRAPHENE_API int getNodesCount() const;
+    GRAPHENE_API void update();
+
+private:
+    struct alignas(16) Matrix {
+        float data[16];  // Row-major, same as Math::Mat4
+    };
+
+    TransformStore() = default;
+
+    int getIndex(int handle) const;
+    int resolveNode(int handle);  // Returns the node index
+    void sortNodes();
+
+    static void multiply(const Matrix& a, const Matrix& b, Matrix& result);
+    static void copy(const Math::Mat4& source, Matrix& destination);
+    static Math::Mat4 copy(const Matrix& source);
+
+    std::vector<Matrix> localTransformations;
+    std::vector<Matrix> localRotations;
+    std::vector<Matrix> worldTransformations;
+    std::vector<Matrix> worldRotations;
+    std::vector<int> parents;  // Node index, -1 for the root nodes
+    std::vector<int> handles;  // Node index to handle, -1 for the destroyed nodes
+    std::vector<char> dirty;  // Changed since the last pass, children inherit it during the pass
+    std::vector<unsigned int> resolvedStamps;  // Changes stamp the node's world was last resolved at
+
+    std::vector<int> chain;  // Resolve scratch, queried node first
+    unsigned int changesStamp = 0;
+
+    std::vector<int> indices;  // Handle to node index, -1 for the free handles
+    std::vector<int> freeHandles;
+
+    int destroyedNodes = 0;
+    bool nodesUnsorted = false;
+    bool nodesDirty = false;
+};
+
+}  // namespace Graphene
+
+#endif  // TRANSFORMSTORE_H
@@ -21,6 +21,7 @@
  */
 
 #include <UniformBuffer.h>
+#include <GLStateCache.h>
 
 namespace Graphene {
 
@@ -30,21 +31,32 @@ UniformBuffer::UniformBuffer(const void* data, size_t dataSize) {
 }
 
 UniformBuffer::~UniformBuffer() {
-    glDeleteBuffers(1, &this->ubo);
+    GetGLStateCache().deleteBuffer(this->ubo);
 }
 
 void UniformBuffer::update(const void* data, size_t dataSize) {
-    glBindBuffer(GL_UNIFORM_BUFFER, this->ubo);
-    glBufferData(GL_UNIFORM_BUFFER, dataSize, data, GL_DYNAMIC_DRAW);
+    GetGLStateCache().bindBuffer(GL_UNIFORM_BUFFER, this->ubo);
+
+    // Reallocate storage only if the size changes
+    if (dataSize == this->size) {
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, dataSize, data);
+    } else {
+        glBufferData(GL_UNIFORM_BUFFER, dataSize, data, GL_DYNAMIC_DRAW);
+        this->size = dataSize;
+    }
 }
 
 void UniformBuffer::update(const void* data, size_t dataSize, size_t dataOffset) {
-    glBindBuffer(GL_UNIFORM_BUFFER, this->ubo);
+    GetGLStateCache().bindBuffer(GL_UNIFORM_BUFFER, this->ubo);
     glBufferSubData(GL_UNIFORM_BUFFER, dataOffset, dataSize, data);
 }
 
 void UniformBuffer::bind(BindPoint bindPoint) {
-    glBindBufferBase(GL_UNIFORM_BUFFER, bindPoint, this->ubo);
+    GetGLStateCache().bindBufferBase(GL_UNIFORM_BUFFER, bindPoint, this->ubo);
+}
+
+void UniformBuffer::bind(BindPoint bindPoint, size_t dataOffset, size_t dataSize) {
+    GetGLStateCache().bindBufferRange(GL_UNIFORM_BUFFER, bindPoint, this->ubo, dataOffset, dataSize);
 }
 
 }  // namespace Graphene
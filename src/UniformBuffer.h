@@ -30,7 +30,7 @@
 
 namespace Graphene {
 
-enum BindPoint { BIND_MATERIAL, BIND_LIGHT };
+enum BindPoint { BIND_MATERIAL, BIND_LIGHT, BIND_LIGHTS };
 
 class UniformBuffer: public NonCopyable {
 public:
@@ -40,9 +40,11 @@ public:
     GRAPHENE_API void update(const void* data, size_t dataSize);
     GRAPHENE_API void update(const void* data, size_t dataSize, size_t dataOffset);
     GRAPHENE_API void bind(BindPoint bindPoint);
+    GRAPHENE_API void bind(BindPoint bindPoint, size_t dataOffset, size_t dataSize);
 
 private:
     GLuint ubo = 0;
+    size_t size = 0;
 };
 
 }  // namespace Graphene
@@ -73,8 +73,9 @@ void Viewport::update() {
         this->camera->setAspectRatio(aspectRatio);
     }
 
-    glViewport(this->left, this->top, this->width, this->height);
-    GetRenderManager().update(this->camera);
+    const GLint viewport[] = { this->left, this->top, this->width, this->height };
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    GetRenderManager().update(this->camera, viewport);
 }
 
 }  // namespace Graphene
@@ -24,6 +24,7 @@
 
 #include <Win32Window.h>
 #include <EngineConfig.h>
+#include <RenderTargetPool.h>
 #include <Input.h>
 #include <Logger.h>
 #include <windowsx.h>
@@ -147,7 +148,11 @@ Win32Window::~Win32Window() {
     this->setFullscreen(false);
 
     this->overlays.clear();
-    this->geometryBuffers.clear();
+    this->geometryViewports.clear();
+    this->frameGraph.reset();
+    this->gpuTimer.reset();
+    this->contextWorker.reset();  // Joins before the shared context goes
+    GetRenderTargetPool().teardown();  // Pooled targets belong to the context
 
     this->destroyContext();
     this->destroyWindow(this->window);
@@ -258,6 +263,17 @@ void Win32Window::swapBuffers() {
     SwapBuffers(this->deviceContext);
 }
 
+void Win32Window::makeSharedContextCurrent() {
+    // Same pixel format as the rendering context, the window device context does
+    if (!wglMakeCurrent(this->deviceContext, this->sharedContext)) {
+        throw std::runtime_error(LogFormat("wglMakeCurrent()"));
+    }
+}
+
+void Win32Window::releaseSharedContext() {
+    wglMakeCurrent(nullptr, nullptr);
+}
+
 HWND Win32Window::createWindow(LPCWSTR className, LPCWSTR windowName, WNDPROC windowProc) {
     WNDCLASSEX windowClass = { };
     windowClass.cbSize = sizeof(windowClass);
@@ -404,6 +420,12 @@ void Win32Window::createExtContext(HWND window) {
     if (!wglMakeCurrent(this->deviceContext, this->renderingContext)) {
         throw std::runtime_error(LogFormat("wglMakeCurrent()"));
     }
+
+    // Shares objects with the rendering context, backs the context worker
+    this->sharedContext = wglCreateContextAttribsARB(this->deviceContext, this->renderingContext, contextAttribList);
+    if (this->sharedContext == nullptr) {
+        throw std::runtime_error(LogFormat("wglCreateContextAttribsARB()"));
+    }
 }
 
 void Win32Window::destroyContext() {
@@ -411,6 +433,11 @@ void Win32Window::destroyContext() {
         wglMakeCurrent(this->deviceContext, nullptr);
     }
 
+    if (this->sharedContext != nullptr) {
+        wglDeleteContext(this->sharedContext);
+        this->sharedContext = nullptr;
+    }
+
     if (this->renderingContext != nullptr) {
         wglDeleteContext(this->renderingContext);
         this->renderingContext = nullptr;
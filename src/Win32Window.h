@@ -44,6 +44,10 @@ public:
     GRAPHENE_API bool dispatchEvents() override;
     GRAPHENE_API void swapBuffers() override;
 
+protected:
+    void makeSharedContextCurrent() override;
+    void releaseSharedContext() override;
+
 private:
     static LRESULT CALLBACK windowProc(HWND window, UINT message, WPARAM wParam, LPARAM lParam);
 
@@ -68,6 +72,7 @@ private:
     HWND window = nullptr;
     HDC deviceContext = nullptr;
     HGLRC renderingContext = nullptr;
+    HGLRC sharedContext = nullptr;
 };
 
 }  // namespace Graphene
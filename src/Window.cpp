@@ -23,12 +23,17 @@
 #include <Window.h>
 #include <OpenGL.h>
 #include <RenderManager.h>
+#include <GLStateCache.h>
+#include <Logger.h>
+#include <stdexcept>
 #include <algorithm>
+#include <functional>
 
 namespace Graphene {
 
 Window::Window(int width, int height):
-        RenderTarget(width, height) {
+        RenderTarget(width, height),
+        frameGraph(new FrameGraph()) {
 }
 
 const KeyboardState& Window::getKeyboardState() const {
@@ -55,6 +60,16 @@ const std::unordered_set<std::string>& Window::getSupportedExtensions() const {
     return this->availableExtensions;
 }
 
+const std::shared_ptr<ContextWorker>& Window::getContextWorker() {
+    if (this->contextWorker == nullptr) {
+        this->contextWorker = std::make_shared<ContextWorker>(
+                std::bind(&Window::makeSharedContextCurrent, this),
+                std::bind(&Window::releaseSharedContext, this));
+    }
+
+    return this->contextWorker;
+}
+
 const std::shared_ptr<Overlay>& Window::createOverlay(int left, int top, int width, int height) {
     auto overlay = std::make_shared<Overlay>(left, top, width, height);
     return this->overlays.emplace_back(overlay);
@@ -64,51 +79,158 @@ const std::vector<std::shared_ptr<Overlay>>& Window::getOverlays() const {
     return this->overlays;
 }
 
+void Window::setDynamicResolution(float targetFps, float minScale, float maxScale) {
+    if (targetFps <= 0.0f) {
+        throw std::invalid_argument(LogFormat("Target FPS is not positive"));
+    }
+
+    this->resolutionController = std::make_shared<ResolutionController>(1000.0f / targetFps, minScale, maxScale);
+}
+
+float Window::getResolutionScale() const {
+    return (this->resolutionController != nullptr) ? this->resolutionController->getScale() : 1.0f;
+}
+
 const std::shared_ptr<Viewport>& Window::createViewport(int left, int top, int width, int height) {
-    auto geometryBuffer = std::make_shared<GeometryBuffer>(width, height);
-    geometryBuffer->createViewport(0, 0, width, height);
+    // G-buffer is sized to the viewport, update() scales it down, geometry is rendered at its origin
+    auto geometryViewport = std::make_shared<Viewport>(0, 0, width, height);
 
     auto& viewport = RenderTarget::createViewport(left, top, width, height);
-    return this->geometryBuffers.emplace(viewport, geometryBuffer).first->first;
+    return this->geometryViewports.emplace(viewport, geometryViewport).first->first;
 }
 
 void Window::update() {
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, this->fbo);
-    glDrawBuffer(GL_BACK);  // Double buffered
+    if (this->resolutionController != nullptr) {
+        if (this->gpuTimer == nullptr) {
+            this->gpuTimer = std::make_shared<GpuTimer>();
+        }
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_ONE, GL_ONE);
-    glDisable(GL_DEPTH_TEST);
-    glClear(GL_COLOR_BUFFER_BIT);
+        if (this->gpuTimer->poll()) {
+            this->resolutionController->update(this->gpuTimer->getElapsedTime());
+        }
 
-    for (auto& viewport: this->viewports) {
-        auto& geometryBuffer = this->geometryBuffers.at(viewport);
-        auto& geometryViewport = *geometryBuffer->getViewports().begin();
-        geometryViewport->setCamera(viewport->getCamera());
+        this->gpuTimer->begin();
+    }
+
+    auto& frameGraph = *this->frameGraph;
+    frameGraph.clear();
+
+    auto backbuffer = frameGraph.importFramebuffer("Backbuffer", this->fbo);
 
-        geometryBuffer->update();
-        geometryBuffer->getDiffuseTexture()->bind(TEXTURE_DIFFUSE);
-        geometryBuffer->getSpecularTexture()->bind(TEXTURE_SPECULAR);
-        geometryBuffer->getPositionTexture()->bind(TEXTURE_POSITION);
-        geometryBuffer->getNormalTexture()->bind(TEXTURE_NORMAL);
+    // Default framebuffer draws to GL_BACK unless told otherwise, double buffered
+    int clearPass = frameGraph.addPass("Clear", [](const FrameGraph& /*frameGraph*/) {
+        glClear(GL_COLOR_BUFFER_BIT);
+    });
+    frameGraph.write(clearPass, backbuffer);
 
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, this->fbo);
-        glDrawBuffer(GL_BACK);  // Double buffered
+    float scale = this->getResolutionScale();
 
-        // glBlendFunc() is already set
-        glEnable(GL_BLEND);
-        glDisable(GL_DEPTH_TEST);
+    for (auto& viewport: this->viewports) {
+        if (viewport->getCamera() == nullptr) {
+            continue;
+        }
+
+        // Viewports are lit one after another, the next G-buffer aliases the previous one
+        int width = std::max(static_cast<int>(viewport->getWidth() * scale), 1);
+        int height = std::max(static_cast<int>(viewport->getHeight() * scale), 1);
+
+        /*
+         * Geometry buffer layout
+         *
+         * Tex0 (RGBA8):   | diffuse R  | diffuse G  | diffuse B         | ambient intensity  |
+         * Tex1 (RGBA8):   | specular R | specular G | specular B        | specular intensity |
+         * Tex2 (RGBA16):  | normal U   | normal V   | diffuse intensity | specular hardness  |
+         * Tex3 (DEPTH24): | depth      |
+         *
+         * Normals are octahedral encoded, hardness is scaled down by 65535. World position is
+         * reconstructed from depth with the inverse view projection, see deferred_lighting.shader
+         */
+        FrameGraphResource gbuffer[] = {
+            frameGraph.createTexture("Diffuse", width, height, GL_RGBA8),
+            frameGraph.createTexture("Specular", width, height, GL_RGBA8),
+            frameGraph.createTexture("Normal", width, height, GL_RGBA16),
+            frameGraph.createTexture("Depth", width, height, GL_DEPTH_COMPONENT24)
+        };
+
+        auto& geometryViewport = this->geometryViewports.at(viewport);
+        if (geometryViewport->getWidth() != width || geometryViewport->getHeight() != height) {
+            geometryViewport = std::make_shared<Viewport>(0, 0, width, height);
+        }
+
+        geometryViewport->setCamera(viewport->getCamera());
 
-        GetRenderManager().setRenderState(RenderFrame::ID);
-        viewport->update();
+        int geometryPass = frameGraph.addPass("Geometry", [geometryViewport](const FrameGraph& /*frameGraph*/) {
+            auto& stateCache = GetGLStateCache();
+            stateCache.disable(GL_BLEND);
+            stateCache.enable(GL_DEPTH_TEST);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+            GetRenderManager().setRenderState(RenderGeometry::ID);
+            geometryViewport->update();
+        });
+
+        // Scaled down frames are lit at the G-buffer size and upscaled into the viewport
+        bool upscaled = width != viewport->getWidth() || height != viewport->getHeight();
+        auto lightingViewport = upscaled ? geometryViewport : viewport;
+
+        int lightingPass = frameGraph.addPass("Lighting", [lightingViewport, gbuffer, upscaled](const FrameGraph& frameGraph) {
+            frameGraph.getTexture(gbuffer[0])->bind(TEXTURE_DIFFUSE);
+            frameGraph.getTexture(gbuffer[1])->bind(TEXTURE_SPECULAR);
+            frameGraph.getTexture(gbuffer[2])->bind(TEXTURE_NORMAL);
+            frameGraph.getTexture(gbuffer[3])->bind(TEXTURE_DEPTH);
+
+            if (upscaled) {
+                glClear(GL_COLOR_BUFFER_BIT);  // Transient target, lights are accumulated
+            }
+
+            auto& stateCache = GetGLStateCache();
+            stateCache.enable(GL_BLEND);
+            stateCache.blendFunc(GL_ONE, GL_ONE);
+            stateCache.disable(GL_DEPTH_TEST);
+
+            GetRenderManager().setRenderState(RenderFrame::ID);
+            lightingViewport->update();
+        });
+
+        for (auto resource: gbuffer) {
+            frameGraph.write(geometryPass, resource);
+            frameGraph.read(lightingPass, resource);
+        }
+
+        if (!upscaled) {
+            frameGraph.write(lightingPass, backbuffer);
+            continue;
+        }
+
+        auto frame = frameGraph.createTexture("Frame", width, height, GL_RGBA16F);
+        frameGraph.write(lightingPass, frame);
+
+        int upscalePass = frameGraph.addPass("Upscale", [viewport, frame](const FrameGraph& frameGraph) {
+            frameGraph.blitTexture(frame, viewport->getLeft(), viewport->getTop(), viewport->getWidth(), viewport->getHeight());
+        });
+
+        frameGraph.read(upscalePass, frame);
+        frameGraph.write(upscalePass, backbuffer);
     }
 
-    // GL_BLEND, GL_DEPTH_TEST are already set
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    int overlaysPass = frameGraph.addPass("Overlays", [this](const FrameGraph& /*frameGraph*/) {
+        auto& stateCache = GetGLStateCache();
+        stateCache.enable(GL_BLEND);
+        stateCache.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        stateCache.disable(GL_DEPTH_TEST);
+
+        for (auto& overlay: this->overlays) {
+            GetRenderManager().setRenderState(RenderOverlay::ID);
+            overlay->update();
+        }
+    });
+    frameGraph.write(overlaysPass, backbuffer);
+
+    frameGraph.compile();
+    frameGraph.execute();
 
-    for (auto& overlay: this->overlays) {
-        GetRenderManager().setRenderState(RenderOverlay::ID);
-        overlay->update();
+    if (this->gpuTimer != nullptr) {
+        this->gpuTimer->end();
     }
 
     this->swapBuffers();
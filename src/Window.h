@@ -26,9 +26,12 @@
 #include <GrapheneApi.h>
 #include <Input.h>
 #include <RenderTarget.h>
-#include <GeometryBuffer.h>
+#include <FrameGraph.h>
+#include <GpuTimer.h>
+#include <ResolutionController.h>
 #include <Viewport.h>
 #include <Overlay.h>
+#include <ContextWorker.h>
 #include <Signals.h>
 #include <string>
 #include <vector>
@@ -50,6 +53,9 @@ public:
     GRAPHENE_API bool isExtensionSupported(const std::string& extension) const;
     GRAPHENE_API const std::unordered_set<std::string>& getSupportedExtensions() const;
 
+    // Thread owning a context shared with the window one, started on the first call
+    GRAPHENE_API const std::shared_ptr<ContextWorker>& getContextWorker();
+
     GRAPHENE_API virtual void captureMouse(bool captured) = 0;
     GRAPHENE_API virtual void setVsync(bool vsync) = 0;
     GRAPHENE_API virtual void setFullscreen(bool fullscreen) = 0;
@@ -60,11 +66,19 @@ public:
     GRAPHENE_API const std::shared_ptr<Overlay>& createOverlay(int left, int top, int width, int height);
     GRAPHENE_API const std::vector<std::shared_ptr<Overlay>>& getOverlays() const;
 
+    GRAPHENE_API void setDynamicResolution(float targetFps, float minScale, float maxScale);
+    GRAPHENE_API float getResolutionScale() const;
+
     GRAPHENE_API const std::shared_ptr<Viewport>& createViewport(int left, int top, int width, int height) override;
     GRAPHENE_API void update() override;
 
 protected:
     friend class Engine;
+
+    // Called on the context worker thread
+    virtual void makeSharedContextCurrent() = 0;
+    virtual void releaseSharedContext() = 0;
+
     Signals::Signal<int, int> onMouseMotionSignal;
     Signals::Signal<MouseButton, bool> onMouseButtonSignal;
     Signals::Signal<KeyboardKey, bool> onKeyboardKeySignal;
@@ -78,8 +92,13 @@ protected:
 
     std::unordered_set<std::string> availableExtensions;
 
-    std::unordered_map<std::shared_ptr<Viewport>, std::shared_ptr<GeometryBuffer>> geometryBuffers;
+    std::unordered_map<std::shared_ptr<Viewport>, std::shared_ptr<Viewport>> geometryViewports;
     std::vector<std::shared_ptr<Overlay>> overlays;
+    std::shared_ptr<FrameGraph> frameGraph;  // Rebuilt every frame, has to go before the context
+
+    std::shared_ptr<ResolutionController> resolutionController;
+    std::shared_ptr<GpuTimer> gpuTimer;  // Created on the first frame, has to go before the context
+    std::shared_ptr<ContextWorker> contextWorker;  // Has to go before the shared context
 };
 
 }  // namespace Graphene
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <TestGraphene.h>
+#include <FrameGraph.h>
+#include <RenderTargetPool.h>
+#include <stdexcept>
+#include <vector>
+
+class TestFrameGraph: public CppUnit::TestFixture {
+public:
+    void setUp() {
+        Graphene::RenderTargetPool::getInstance().teardown();
+    }
+
+    void testCulling() {
+        Graphene::FrameGraph frameGraph;
+        auto backbuffer = frameGraph.importFramebuffer("Backbuffer", 0);
+        auto first = frameGraph.createTexture("First", 4, 4, GL_RGBA8);
+        auto second = frameGraph.createTexture("Second", 4, 4, GL_RGBA8);
+
+        auto noop = [](const Graphene::FrameGraph&) { };
+        int firstPass = frameGraph.addPass("First", noop);
+        int secondPass = frameGraph.addPass("Second", noop);
+        int outputPass = frameGraph.addPass("Output", noop);
+
+        frameGraph.write(firstPass, first);
+        frameGraph.read(secondPass, first);
+        frameGraph.write(secondPass, second);  // Never read
+        frameGraph.write(outputPass, backbuffer);
+
+        frameGraph.compile();
+        CPPUNIT_ASSERT_EQUAL(frameGraph.getCulledPasses(), 2);
+        CPPUNIT_ASSERT(frameGraph.getPassOrder() == std::vector<int>({ outputPass }));
+    }
+
+    void testOrder() {
+        Graphene::FrameGraph frameGraph;
+        auto backbuffer = frameGraph.importFramebuffer("Backbuffer", 0);
+        auto texture = frameGraph.createTexture("Texture", 4, 4, GL_RGBA8);
+
+        auto noop = [](const Graphene::FrameGraph&) { };
+        int clearPass = frameGraph.addPass("Clear", noop);
+        int texturePass = frameGraph.addPass("Texture", noop);
+        int backgroundPass = frameGraph.addPass("Background", noop);
+        int compositePass = frameGraph.addPass("Composite", noop);
+
+        frameGraph.write(clearPass, backbuffer);
+        frameGraph.write(texturePass, texture);
+        frameGraph.write(backgroundPass, backbuffer);
+        frameGraph.read(compositePass, texture);
+        frameGraph.write(compositePass, backbuffer);
+
+        // Background follows Clear on the same framebuffer, Composite waits for Texture
+        frameGraph.compile();
+        CPPUNIT_ASSERT_EQUAL(frameGraph.getCulledPasses(), 0);
+        CPPUNIT_ASSERT(frameGraph.getPassOrder() == std::vector<int>({ clearPass, backgroundPass, texturePass, compositePass }));
+
+        Graphene::FrameGraph invalidGraph;
+        auto unwritten = invalidGraph.createTexture("Unwritten", 4, 4, GL_RGBA8);
+        int readPass = invalidGraph.addPass("Read", noop);
+        invalidGraph.read(readPass, unwritten);
+        invalidGraph.write(readPass, invalidGraph.importFramebuffer("Backbuffer", 0));
+        CPPUNIT_ASSERT_THROW(invalidGraph.compile(), std::runtime_error);
+    }
+
+    void testAliasing() {
+        Graphene::FrameGraph frameGraph;
+        auto backbuffer = frameGraph.importFramebuffer("Backbuffer", 0);
+        std::vector<int> executed;
+
+        for (int viewport = 0; viewport < 2; viewport++) {
+            auto color = frameGraph.createTexture("Color", 4, 4, GL_RGBA8);
+            auto depth = frameGraph.createTexture("Depth", 4, 4, GL_DEPTH_COMPONENT24);
+
+            int renderPass = frameGraph.addPass("Render", [&executed, &frameGraph, color, depth](const Graphene::FrameGraph&) {
+                CPPUNIT_ASSERT(frameGraph.getTexture(color) != nullptr);
+                CPPUNIT_ASSERT(frameGraph.getTexture(depth) != nullptr);
+                executed.push_back(0);
+            });
+
+            int resolvePass = frameGraph.addPass("Resolve", [&executed](const Graphene::FrameGraph&) {
+                executed.push_back(1);
+            });
+
+            frameGraph.write(renderPass, color);
+            frameGraph.write(renderPass, depth);
+            frameGraph.read(resolvePass, color);
+            frameGraph.read(resolvePass, depth);
+            frameGraph.write(resolvePass, backbuffer);
+        }
+
+        frameGraph.execute();
+        CPPUNIT_ASSERT(executed == std::vector<int>({ 0, 1, 0, 1 }));
+
+        // Second viewport reuses the storage released after the first one resolved
+        auto& renderTargetPool = Graphene::RenderTargetPool::getInstance();
+        CPPUNIT_ASSERT_EQUAL(renderTargetPool.getPooledTargets(), 2);
+        CPPUNIT_ASSERT_EQUAL(renderTargetPool.getPooledMemory(), static_cast<size_t>(4 * 4 * 4 * 2));
+    }
+};
+
+int main() {
+    CppUnit::TestSuite* suite = new CppUnit::TestSuite("TestFrameGraph");
+    suite->addTest(new CppUnit::TestCaller<TestFrameGraph>("testCulling", &TestFrameGraph::testCulling));
+    suite->addTest(new CppUnit::TestCaller<TestFrameGraph>("testOrder", &TestFrameGraph::testOrder));
+    suite->addTest(new CppUnit::TestCaller<TestFrameGraph>("testAliasing", &TestFrameGraph::testAliasing));
+
+    CppUnit::TextTestRunner runner;
+    runner.addTest(suite);
+
+    return runner.run() ? 0 : 1;
+}
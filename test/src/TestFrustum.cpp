@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <TestGraphene.h>
+#include <BoundingVolume.h>
+#include <Frustum.h>
+#include <Mat4.h>
+#include <Vec3.h>
+
+class TestFrustum: public CppUnit::TestFixture {
+public:
+    void testBoundingBox() {
+        Graphene::BoundingBox box;
+        CPPUNIT_ASSERT(box.isEmpty());
+
+        box.merge(Math::Vec3(-1.0f, 0.0f, 2.0f));
+        box.merge(Math::Vec3(1.0f, 2.0f, 0.0f));
+        CPPUNIT_ASSERT(!box.isEmpty());
+        ASSERT_VEC3_EQUAL(box.getMinimum(), Math::Vec3(-1.0f, 0.0f, 0.0f));
+        ASSERT_VEC3_EQUAL(box.getMaximum(), Math::Vec3(1.0f, 2.0f, 2.0f));
+        ASSERT_VEC3_EQUAL(box.getCenter(), Math::Vec3(0.0f, 1.0f, 1.0f));
+
+        Math::Mat4 transformation;
+        transformation.set(0, 0, 2.0f);
+        transformation.set(0, 3, 5.0f);
+
+        Graphene::BoundingBox transformedBox(box.transform(transformation));
+        ASSERT_VEC3_EQUAL(transformedBox.getMinimum(), Math::Vec3(3.0f, 0.0f, 0.0f));
+        ASSERT_VEC3_EQUAL(transformedBox.getMaximum(), Math::Vec3(7.0f, 2.0f, 2.0f));
+    }
+
+    void testBoundingSphere() {
+        Graphene::BoundingSphere sphere;
+        CPPUNIT_ASSERT(sphere.isEmpty());
+
+        sphere.merge(Graphene::BoundingSphere(Math::Vec3(-1.0f, 0.0f, 0.0f), 1.0f));
+        sphere.merge(Graphene::BoundingSphere(Math::Vec3(2.0f, 0.0f, 0.0f), 1.0f));
+        ASSERT_VEC3_EQUAL(sphere.getCenter(), Math::Vec3(0.5f, 0.0f, 0.0f));
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(sphere.getRadius(), 2.5f, 0.001f);
+    }
+
+    void testIntersects() {
+        Graphene::Frustum frustum((Math::Mat4()));  // NDC cube
+
+        CPPUNIT_ASSERT(frustum.intersects(Graphene::BoundingBox(Math::Vec3(-0.5f, -0.5f, -0.5f), Math::Vec3(0.5f, 0.5f, 0.5f))));
+        CPPUNIT_ASSERT(frustum.intersects(Graphene::BoundingBox(Math::Vec3(0.5f, 0.5f, 0.5f), Math::Vec3(1.5f, 1.5f, 1.5f))));
+        CPPUNIT_ASSERT(!frustum.intersects(Graphene::BoundingBox(Math::Vec3(1.5f, -0.5f, -0.5f), Math::Vec3(2.5f, 0.5f, 0.5f))));
+        CPPUNIT_ASSERT(!frustum.intersects(Graphene::BoundingBox()));
+
+        CPPUNIT_ASSERT(frustum.intersects(Graphene::BoundingSphere(Math::Vec3(0.0f, 1.5f, 0.0f), 1.0f)));
+        CPPUNIT_ASSERT(!frustum.intersects(Graphene::BoundingSphere(Math::Vec3(0.0f, 0.0f, -2.5f), 1.0f)));
+    }
+};
+
+int main() {
+    CppUnit::TestSuite* suite = new CppUnit::TestSuite("TestFrustum");
+    suite->addTest(new CppUnit::TestCaller<TestFrustum>("testBoundingBox", &TestFrustum::testBoundingBox));
+    suite->addTest(new CppUnit::TestCaller<TestFrustum>("testBoundingSphere", &TestFrustum::testBoundingSphere));
+    suite->addTest(new CppUnit::TestCaller<TestFrustum>("testIntersects", &TestFrustum::testIntersects));
+
+    CppUnit::TextTestRunner runner;
+    runner.addTest(suite);
+
+    return runner.run() ? 0 : 1;
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <TestGraphene.h>
+#include <GLStateCache.h>
+
+class TestGLStateCache: public CppUnit::TestFixture {
+public:
+    void setUp() {
+        auto& stateCache = Graphene::GLStateCache::getInstance();
+        stateCache.invalidate();
+        stateCache.resetCounters();
+    }
+
+    void testCapabilities() {
+        auto& stateCache = Graphene::GLStateCache::getInstance();
+
+        stateCache.enable(GL_BLEND);
+        stateCache.enable(GL_BLEND);
+        stateCache.disable(GL_DEPTH_TEST);
+        stateCache.disable(GL_BLEND);
+        CPPUNIT_ASSERT_EQUAL(stateCache.getIssuedCalls(), 3);
+        CPPUNIT_ASSERT_EQUAL(stateCache.getElidedCalls(), 1);
+
+        stateCache.invalidate();
+        stateCache.disable(GL_BLEND);
+        CPPUNIT_ASSERT_EQUAL(stateCache.getIssuedCalls(), 4);
+
+        stateCache.colorMask(GL_FALSE);
+        stateCache.colorMask(GL_FALSE);
+        stateCache.depthMask(GL_FALSE);
+        stateCache.depthMask(GL_TRUE);
+        CPPUNIT_ASSERT_EQUAL(stateCache.getIssuedCalls(), 7);
+        CPPUNIT_ASSERT_EQUAL(stateCache.getElidedCalls(), 2);
+    }
+
+    void testScissor() {
+        auto& stateCache = Graphene::GLStateCache::getInstance();
+
+        stateCache.scissor(0, 0, 0, 0);  // Empty box differs from the invalidated one
+        stateCache.scissor(0, 0, 0, 0);
+        stateCache.scissor(16, 32, 64, 64);
+        stateCache.scissor(16, 32, 64, 128);
+        CPPUNIT_ASSERT_EQUAL(stateCache.getIssuedCalls(), 3);
+        CPPUNIT_ASSERT_EQUAL(stateCache.getElidedCalls(), 1);
+
+        stateCache.invalidate();
+        stateCache.scissor(16, 32, 64, 128);
+        CPPUNIT_ASSERT_EQUAL(stateCache.getIssuedCalls(), 4);
+    }
+
+    void testBuffers() {
+        auto& stateCache = Graphene::GLStateCache::getInstance();
+
+        stateCache.bindBuffer(GL_ARRAY_BUFFER, 1);
+        stateCache.bindBuffer(GL_ARRAY_BUFFER, 1);
+        CPPUNIT_ASSERT_EQUAL(stateCache.getIssuedCalls(), 1);
+        CPPUNIT_ASSERT_EQUAL(stateCache.getElidedCalls(), 1);
+
+        stateCache.bindBufferRange(GL_ARRAY_BUFFER, 0, 2, 0, 64);
+        stateCache.bindBufferRange(GL_ARRAY_BUFFER, 0, 2, 0, 64);
+        stateCache.bindBufferRange(GL_ARRAY_BUFFER, 0, 2, 64, 64);
+        stateCache.bindBuffer(GL_ARRAY_BUFFER, 2);  // Replaced by the indexed binding
+        CPPUNIT_ASSERT_EQUAL(stateCache.getIssuedCalls(), 3);
+        CPPUNIT_ASSERT_EQUAL(stateCache.getElidedCalls(), 3);
+
+        stateCache.deleteBuffer(2);
+        stateCache.bindBuffer(GL_ARRAY_BUFFER, 0);
+        CPPUNIT_ASSERT_EQUAL(stateCache.getIssuedCalls(), 3);
+        CPPUNIT_ASSERT_EQUAL(stateCache.getElidedCalls(), 4);
+    }
+
+    void testVertexArray() {
+        auto& stateCache = Graphene::GLStateCache::getInstance();
+
+        stateCache.bindVertexArray(1);
+        stateCache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 3);
+        stateCache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 3);
+        CPPUNIT_ASSERT_EQUAL(stateCache.getIssuedCalls(), 2);
+
+        stateCache.bindVertexArray(2);
+        stateCache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 3);  // Element array binding belongs to the VAO
+        CPPUNIT_ASSERT_EQUAL(stateCache.getIssuedCalls(), 4);
+
+        stateCache.deleteVertexArray(2);
+        stateCache.bindVertexArray(0);
+        CPPUNIT_ASSERT_EQUAL(stateCache.getIssuedCalls(), 4);
+        CPPUNIT_ASSERT_EQUAL(stateCache.getElidedCalls(), 2);
+    }
+
+    void testTextures() {
+        auto& stateCache = Graphene::GLStateCache::getInstance();
+
+        stateCache.bindTexture(0, GL_TEXTURE_2D, 1);  // glActiveTexture(), glBindTexture()
+        stateCache.bindTexture(1, GL_TEXTURE_2D, 1);  // Same texture, other unit
+        CPPUNIT_ASSERT_EQUAL(stateCache.getIssuedCalls(), 4);
+
+        stateCache.bindTexture(0, GL_TEXTURE_2D, 1);
+        stateCache.bindTexture(1, GL_TEXTURE_2D, 1);
+        CPPUNIT_ASSERT_EQUAL(stateCache.getIssuedCalls(), 4);
+        CPPUNIT_ASSERT_EQUAL(stateCache.getElidedCalls(), 2);
+
+        stateCache.deleteTexture(1);
+        stateCache.bindTexture(0, GL_TEXTURE_2D, 0);
+        CPPUNIT_ASSERT_EQUAL(stateCache.getIssuedCalls(), 4);
+        CPPUNIT_ASSERT_EQUAL(stateCache.getElidedCalls(), 3);
+    }
+
+    void testFramebuffers() {
+        auto& stateCache = Graphene::GLStateCache::getInstance();
+
+        stateCache.bindFramebuffer(GL_FRAMEBUFFER, 1);
+        stateCache.bindFramebuffer(GL_DRAW_FRAMEBUFFER, 1);
+        stateCache.bindFramebuffer(GL_READ_FRAMEBUFFER, 1);
+        CPPUNIT_ASSERT_EQUAL(stateCache.getIssuedCalls(), 1);
+        CPPUNIT_ASSERT_EQUAL(stateCache.getElidedCalls(), 2);
+
+        stateCache.bindFramebuffer(GL_DRAW_FRAMEBUFFER, 2);
+        stateCache.bindFramebuffer(GL_FRAMEBUFFER, 1);
+        CPPUNIT_ASSERT_EQUAL(stateCache.getIssuedCalls(), 3);
+
+        stateCache.deleteFramebuffer(1);
+        stateCache.bindFramebuffer(GL_FRAMEBUFFER, 0);
+        CPPUNIT_ASSERT_EQUAL(stateCache.getIssuedCalls(), 3);
+        CPPUNIT_ASSERT_EQUAL(stateCache.getElidedCalls(), 3);
+    }
+};
+
+int main() {
+    CppUnit::TestSuite* suite = new CppUnit::TestSuite("TestGLStateCache");
+    suite->addTest(new CppUnit::TestCaller<TestGLStateCache>("testCapabilities", &TestGLStateCache::testCapabilities));
+    suite->addTest(new CppUnit::TestCaller<TestGLStateCache>("testScissor", &TestGLStateCache::testScissor));
+    suite->addTest(new CppUnit::TestCaller<TestGLStateCache>("testBuffers", &TestGLStateCache::testBuffers));
+    suite->addTest(new CppUnit::TestCaller<TestGLStateCache>("testVertexArray", &TestGLStateCache::testVertexArray));
+    suite->addTest(new CppUnit::TestCaller<TestGLStateCache>("testTextures", &TestGLStateCache::testTextures));
+    suite->addTest(new CppUnit::TestCaller<TestGLStateCache>("testFramebuffers", &TestGLStateCache::testFramebuffers));
+
+    CppUnit::TextTestRunner runner;
+    runner.addTest(suite);
+
+    return runner.run() ? 0 : 1;
+}
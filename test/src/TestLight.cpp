@@ -22,11 +22,48 @@
 
 #include <TestGraphene.h>
 #include <Light.h>
+#include <Vec3.h>
+#include <cmath>
 
-class TestLight: public CppUnit::TestFixture { };
+class TestLight: public CppUnit::TestFixture {
+public:
+    void testBoundingSphere() {
+        Math::Vec3 position(1.0f, 0.0f, 0.0f);
+        Math::Vec3 direction(0.0f, 0.0f, -1.0f);
+
+        Graphene::Light light(Graphene::LightType::POINT);
+        light.setFalloff(1.0f);
+        float range = light.getRange();
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(range, sqrtf(255.0f), 0.001f);
+
+        auto pointSphere = light.getBoundingSphere(position, direction);
+        ASSERT_VEC3_EQUAL(pointSphere.getCenter(), position);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(pointSphere.getRadius(), range, 0.001f);
+
+        // Narrow cone, sphere passes through the apex
+        light.setLightType(Graphene::LightType::SPOT);
+        light.setAngle(90.0f);
+        float narrowRadius = range / (2.0f * cosf(static_cast<float>(M_PI) / 4.0f));
+
+        auto narrowSphere = light.getBoundingSphere(position, direction);
+        ASSERT_VEC3_EQUAL(narrowSphere.getCenter(), Math::Vec3(1.0f, 0.0f, -narrowRadius));
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(narrowSphere.getRadius(), narrowRadius, 0.001f);
+
+        // Wide cone, sphere is centered on the cap
+        light.setAngle(120.0f);
+
+        auto wideSphere = light.getBoundingSphere(position, direction);
+        ASSERT_VEC3_EQUAL(wideSphere.getCenter(), Math::Vec3(1.0f, 0.0f, -range * 0.5f));
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(wideSphere.getRadius(), range * sqrtf(3.0f) * 0.5f, 0.001f);
+
+        light.setLightType(Graphene::LightType::DIRECTED);
+        CPPUNIT_ASSERT(std::isinf(light.getBoundingSphere(position, direction).getRadius()));
+    }
+};
 
 int main() {
     CppUnit::TestSuite* suite = new CppUnit::TestSuite("TestLight");
+    suite->addTest(new CppUnit::TestCaller<TestLight>("testBoundingSphere", &TestLight::testBoundingSphere));
 
     CppUnit::TextTestRunner runner;
     runner.addTest(suite);
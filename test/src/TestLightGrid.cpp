@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <TestGraphene.h>
+#include <LightGrid.h>
+#include <BoundingVolume.h>
+#include <Camera.h>
+#include <Mat4.h>
+#include <Vec3.h>
+#include <stdexcept>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <cmath>
+
+class TestLightGrid: public CppUnit::TestFixture {
+public:
+    void testUpdate() {
+        auto camera = std::make_shared<Graphene::Camera>(Graphene::ProjectionType::PERSPECTIVE);
+        Graphene::LightGrid lightGrid(4, 4, 8);
+
+        std::vector<Graphene::BoundingSphere> lightVolumes = {
+            Graphene::BoundingSphere(Math::Vec3(0.0f, 0.0f, 10.0f), 1.0f),   // Straight ahead
+            Graphene::BoundingSphere(Math::Vec3(0.0f, 0.0f, -10.0f), 1.0f),  // Behind the camera
+            Graphene::BoundingSphere(Math::Vec3(0.0f, 0.0f, 0.0f), std::numeric_limits<float>::infinity())
+        };
+
+        lightGrid.update(camera, Math::Mat4(), lightVolumes);
+
+        auto& cells = lightGrid.getCells();
+        auto& indices = lightGrid.getIndices();
+        CPPUNIT_ASSERT_EQUAL(cells.size(), static_cast<size_t>(4 * 4 * 8 * 2));
+
+        int slice = static_cast<int>(logf(10.0f) * lightGrid.getDepthScale() + lightGrid.getDepthBias());
+        int centerCell = (slice * 4 + 2) * 4 + 2;
+        int cornerCell = (slice * 4 + 0) * 4 + 0;
+
+        CPPUNIT_ASSERT_EQUAL(cells[centerCell * 2 + 1], 2u);
+        CPPUNIT_ASSERT_EQUAL(indices[cells[centerCell * 2]], 0u);
+        CPPUNIT_ASSERT_EQUAL(indices[cells[centerCell * 2] + 1], 2u);
+
+        CPPUNIT_ASSERT_EQUAL(cells[cornerCell * 2 + 1], 1u);
+        CPPUNIT_ASSERT_EQUAL(indices[cells[cornerCell * 2]], 2u);
+
+        for (size_t index = 0; index < indices.size(); index++) {
+            CPPUNIT_ASSERT(indices[index] != 1u);
+        }
+    }
+
+    void testProjection() {
+        auto camera = std::make_shared<Graphene::Camera>(Graphene::ProjectionType::ORTHOGRAPHIC);
+        Graphene::LightGrid lightGrid(4, 4, 8);
+
+        std::vector<Graphene::BoundingSphere> lightVolumes;
+        CPPUNIT_ASSERT_THROW(lightGrid.update(camera, Math::Mat4(), lightVolumes), std::invalid_argument);
+    }
+};
+
+int main() {
+    CppUnit::TestSuite* suite = new CppUnit::TestSuite("TestLightGrid");
+    suite->addTest(new CppUnit::TestCaller<TestLightGrid>("testUpdate", &TestLightGrid::testUpdate));
+    suite->addTest(new CppUnit::TestCaller<TestLightGrid>("testProjection", &TestLightGrid::testProjection));
+
+    CppUnit::TextTestRunner runner;
+    runner.addTest(suite);
+
+    return runner.run() ? 0 : 1;
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <TestGraphene.h>
+#include <MeshTree.h>
+#include <Vec3.h>
+#include <limits>
+#include <vector>
+
+#define GRID_CELLS 8
+
+class TestMeshTree: public CppUnit::TestFixture {
+public:
+    void setUp() {
+        // Unit cells in the z = 0 plane, two triangles each
+        this->positions.clear();
+        this->indices.clear();
+
+        for (int y = 0; y <= GRID_CELLS; y++) {
+            for (int x = 0; x <= GRID_CELLS; x++) {
+                this->positions.insert(this->positions.end(), { static_cast<float>(x), static_cast<float>(y), 0.0f });
+            }
+        }
+
+        for (int y = 0; y < GRID_CELLS; y++) {
+            for (int x = 0; x < GRID_CELLS; x++) {
+                int corner = y * (GRID_CELLS + 1) + x;
+                int above = corner + GRID_CELLS + 1;
+
+                this->indices.insert(this->indices.end(), { corner, above, above + 1 });
+                this->indices.insert(this->indices.end(), { corner, above + 1, corner + 1 });
+            }
+        }
+    }
+
+    void testBuild() {
+        Graphene::MeshTree meshTree(this->positions, this->indices);
+        CPPUNIT_ASSERT_EQUAL(meshTree.getTriangles(), GRID_CELLS * GRID_CELLS * 2);
+        CPPUNIT_ASSERT(meshTree.getNodes() > 1);
+        CPPUNIT_ASSERT(meshTree.getNodes() < meshTree.getTriangles());
+
+        std::vector<float> noPositions;
+        std::vector<int> noIndices;
+        Graphene::MeshTree emptyTree(noPositions, noIndices);
+        CPPUNIT_ASSERT_EQUAL(emptyTree.getNodes(), 0);
+
+        float distance = std::numeric_limits<float>::infinity();
+        int triangle = -1;
+        CPPUNIT_ASSERT(!emptyTree.raycast(Math::Vec3(0.5f, 0.5f, 1.0f), Math::Vec3(0.0f, 0.0f, -1.0f), distance, triangle));
+    }
+
+    void testRaycast() {
+        Graphene::MeshTree meshTree(this->positions, this->indices);
+
+        for (int y = 0; y < GRID_CELLS; y++) {
+            for (int x = 0; x < GRID_CELLS; x++) {
+                int cellTriangle = (y * GRID_CELLS + x) * 2;
+
+                float distance = std::numeric_limits<float>::infinity();
+                int triangle = -1;
+                Math::Vec3 origin(x + 0.25f, y + 0.75f, 2.0f);
+                CPPUNIT_ASSERT(meshTree.raycast(origin, Math::Vec3(0.0f, 0.0f, -1.0f), distance, triangle));
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(distance, 2.0f, 0.0001f);
+                CPPUNIT_ASSERT_EQUAL(triangle, cellTriangle);
+
+                // Back side is hit as well
+                distance = std::numeric_limits<float>::infinity();
+                origin = Math::Vec3(x + 0.75f, y + 0.25f, -3.0f);
+                CPPUNIT_ASSERT(meshTree.raycast(origin, Math::Vec3(0.0f, 0.0f, 1.0f), distance, triangle));
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(distance, 3.0f, 0.0001f);
+                CPPUNIT_ASSERT_EQUAL(triangle, cellTriangle + 1);
+            }
+        }
+    }
+
+    void testNearest() {
+        // Second grid below the first, the nearest one wins
+        auto positions = this->positions;
+        auto indices = this->indices;
+        int vertices = static_cast<int>(positions.size()) / 3;
+
+        for (int vertex = 0; vertex < vertices; vertex++) {
+            positions.insert(positions.end(), { positions[vertex * 3], positions[vertex * 3 + 1], -1.0f });
+        }
+
+        for (auto index: this->indices) {
+            indices.push_back(index + vertices);
+        }
+
+        Graphene::MeshTree meshTree(positions, indices);
+        Math::Vec3 direction(0.0f, 0.0f, -1.0f);
+
+        float distance = std::numeric_limits<float>::infinity();
+        int triangle = -1;
+        CPPUNIT_ASSERT(meshTree.raycast(Math::Vec3(3.25f, 5.75f, 1.0f), direction, distance, triangle));
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(distance, 1.0f, 0.0001f);
+        CPPUNIT_ASSERT_EQUAL(triangle, (5 * GRID_CELLS + 3) * 2);
+
+        distance = std::numeric_limits<float>::infinity();
+        CPPUNIT_ASSERT(meshTree.raycast(Math::Vec3(3.25f, 5.75f, -0.5f), direction, distance, triangle));
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(distance, 0.5f, 0.0001f);
+        CPPUNIT_ASSERT_EQUAL(triangle, (5 * GRID_CELLS + 3) * 2 + GRID_CELLS * GRID_CELLS * 2);
+    }
+
+    void testMiss() {
+        Graphene::MeshTree meshTree(this->positions, this->indices);
+        float distance = std::numeric_limits<float>::infinity();
+        int triangle = -1;
+
+        CPPUNIT_ASSERT(!meshTree.raycast(Math::Vec3(4.5f, 4.5f, 1.0f), Math::Vec3(0.0f, 0.0f, 1.0f), distance, triangle));
+        CPPUNIT_ASSERT(!meshTree.raycast(Math::Vec3(-1.0f, 4.5f, 1.0f), Math::Vec3(0.0f, 0.0f, -1.0f), distance, triangle));
+        CPPUNIT_ASSERT(!meshTree.raycast(Math::Vec3(-1.0f, 4.5f, 0.0f), Math::Vec3(1.0f, 0.0f, 0.0f), distance, triangle));
+        CPPUNIT_ASSERT_EQUAL(triangle, -1);
+
+        // Beyond the passed distance
+        distance = 1.0f;
+        CPPUNIT_ASSERT(!meshTree.raycast(Math::Vec3(4.5f, 4.5f, 2.0f), Math::Vec3(0.0f, 0.0f, -1.0f), distance, triangle));
+        CPPUNIT_ASSERT_EQUAL(distance, 1.0f);
+    }
+
+    void testScale() {
+        // Tiny units and a short direction, as with a scaled up entity in its local space
+        auto positions = this->positions;
+        for (auto& position: positions) {
+            position *= 0.0001f;
+        }
+
+        Graphene::MeshTree meshTree(positions, this->indices);
+        float distance = std::numeric_limits<float>::infinity();
+        int triangle = -1;
+
+        CPPUNIT_ASSERT(meshTree.raycast(Math::Vec3(0.000325f, 0.000575f, 0.0002f), Math::Vec3(0.0f, 0.0f, -0.001f), distance, triangle));
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(distance, 0.2f, 0.0001f);
+        CPPUNIT_ASSERT_EQUAL(triangle, (5 * GRID_CELLS + 3) * 2);
+
+        // Still parallel at that scale
+        distance = std::numeric_limits<float>::infinity();
+        CPPUNIT_ASSERT(!meshTree.raycast(Math::Vec3(-0.0001f, 0.00045f, 0.0f), Math::Vec3(0.001f, 0.0f, 0.0f), distance, triangle));
+    }
+
+private:
+    std::vector<float> positions;
+    std::vector<int> indices;
+};
+
+int main() {
+    CppUnit::TestSuite* suite = new CppUnit::TestSuite("TestMeshTree");
+    suite->addTest(new CppUnit::TestCaller<TestMeshTree>("testBuild", &TestMeshTree::testBuild));
+    suite->addTest(new CppUnit::TestCaller<TestMeshTree>("testRaycast", &TestMeshTree::testRaycast));
+    suite->addTest(new CppUnit::TestCaller<TestMeshTree>("testNearest", &TestMeshTree::testNearest));
+    suite->addTest(new CppUnit::TestCaller<TestMeshTree>("testMiss", &TestMeshTree::testMiss));
+    suite->addTest(new CppUnit::TestCaller<TestMeshTree>("testScale", &TestMeshTree::testScale));
+
+    CppUnit::TextTestRunner runner;
+    runner.addTest(suite);
+
+    return runner.run() ? 0 : 1;
+}
@@ -22,11 +22,79 @@
 
 #include <TestGraphene.h>
 #include <ObjectGroup.h>
+#include <Entity.h>
+#include <Component.h>
+#include <MetaObject.h>
+#include <BoundingVolume.h>
+#include <Vec3.h>
+#include <memory>
 
-class TestObjectGroup: public CppUnit::TestFixture { };
+class GrapheneComponent: public Graphene::MetaObject<GrapheneComponent>, public Graphene::Component {
+public:
+    // Graphene::Component() is protected, sub-class to test
+    GrapheneComponent():
+            Graphene::Component(GrapheneComponent::ID) {
+    }
+
+    void receiveEvent(const std::shared_ptr<Graphene::ComponentEvent>& /*event*/) override { }
+    void update(float /*deltaTime*/) override { }
+
+    Graphene::BoundingBox getBoundingBox() const override {
+        return Graphene::BoundingBox(Math::Vec3(-1.0f, -1.0f, -1.0f), Math::Vec3(1.0f, 1.0f, 1.0f));
+    }
+};
+
+class TestObjectGroup: public CppUnit::TestFixture {
+public:
+    void testWorldTransformation() {
+        auto parent = std::make_shared<Graphene::ObjectGroup>();
+        auto child = std::make_shared<Graphene::ObjectGroup>();
+
+        parent->translate(1.0f, 0.0f, 0.0f);
+        child->translate(0.0f, 1.0f, 0.0f);
+        ASSERT_VEC3_EQUAL(child->getWorldPosition(), Math::Vec3(0.0f, 1.0f, 0.0f));
+
+        parent->addObject(child);
+        ASSERT_VEC3_EQUAL(child->getWorldPosition(), Math::Vec3(1.0f, 1.0f, 0.0f));
+
+        parent->translate(2.0f, 0.0f, 0.0f);
+        ASSERT_VEC3_EQUAL(child->getWorldPosition(), Math::Vec3(2.0f, 1.0f, 0.0f));
+
+        parent->scale(2.0f, 2.0f, 2.0f);
+        ASSERT_VEC3_EQUAL(child->getWorldPosition(), Math::Vec3(2.0f, 2.0f, 0.0f));
+    }
+
+    void testBoundingBox() {
+        auto parent = std::make_shared<Graphene::ObjectGroup>();
+        auto child = std::make_shared<Graphene::ObjectGroup>();
+        auto entity = std::make_shared<Graphene::Entity>();
+
+        parent->addObject(child);
+        child->addObject(entity);
+        CPPUNIT_ASSERT(parent->getBoundingBox().isEmpty());
+
+        entity->addComponent(std::make_shared<GrapheneComponent>());
+        ASSERT_VEC3_EQUAL(parent->getBoundingBox().getMinimum(), Math::Vec3(-1.0f, -1.0f, -1.0f));
+        ASSERT_VEC3_EQUAL(parent->getBoundingBox().getMaximum(), Math::Vec3(1.0f, 1.0f, 1.0f));
+
+        entity->translate(2.0f, 0.0f, 0.0f);
+        ASSERT_VEC3_EQUAL(parent->getBoundingBox().getMinimum(), Math::Vec3(1.0f, -1.0f, -1.0f));
+        ASSERT_VEC3_EQUAL(parent->getBoundingBox().getMaximum(), Math::Vec3(3.0f, 1.0f, 1.0f));
+
+        child->scale(2.0f, 2.0f, 2.0f);
+        ASSERT_VEC3_EQUAL(parent->getBoundingBox().getMinimum(), Math::Vec3(2.0f, -2.0f, -2.0f));
+        ASSERT_VEC3_EQUAL(parent->getBoundingBox().getMaximum(), Math::Vec3(6.0f, 2.0f, 2.0f));
+
+        parent->translate(0.0f, 5.0f, 0.0f);  // Group bounds are in the group's local space
+        ASSERT_VEC3_EQUAL(parent->getBoundingBox().getMinimum(), Math::Vec3(2.0f, -2.0f, -2.0f));
+        ASSERT_VEC3_EQUAL(child->getBoundingBox().getMinimum(), Math::Vec3(1.0f, -1.0f, -1.0f));
+    }
+};
 
 int main() {
     CppUnit::TestSuite* suite = new CppUnit::TestSuite("TestObjectGroup");
+    suite->addTest(new CppUnit::TestCaller<TestObjectGroup>("testWorldTransformation", &TestObjectGroup::testWorldTransformation));
+    suite->addTest(new CppUnit::TestCaller<TestObjectGroup>("testBoundingBox", &TestObjectGroup::testBoundingBox));
 
     CppUnit::TextTestRunner runner;
     runner.addTest(suite);
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <TestGraphene.h>
+#include <OcclusionBuffer.h>
+#include <BoundingVolume.h>
+#include <Mat4.h>
+#include <Vec3.h>
+#include <vector>
+
+#define BUFFER_WIDTH  64
+#define BUFFER_HEIGHT 32
+
+class TestOcclusionBuffer: public CppUnit::TestFixture {
+public:
+    void setUp() {
+        // Left half of the screen at NDC depth 0, clockwise from the front, identity projection
+        this->positions = {
+            -1.0f, -1.0f, 0.0f,
+             0.0f, -1.0f, 0.0f,
+             0.0f,  1.0f, 0.0f,
+            -1.0f,  1.0f, 0.0f
+        };
+
+        this->frontFaces = { 0, 3, 2, 0, 2, 1 };
+        this->backFaces = { 0, 2, 3, 0, 1, 2 };
+    }
+
+    void testRasterize() {
+        Graphene::OcclusionBuffer occlusionBuffer(BUFFER_WIDTH, BUFFER_HEIGHT, 0);
+        occlusionBuffer.clear(Math::Mat4());
+        occlusionBuffer.addOccluder(this->positions, this->frontFaces, Math::Mat4());
+        occlusionBuffer.rasterize();
+
+        CPPUNIT_ASSERT_EQUAL(occlusionBuffer.getRasterizedTriangles(), 2);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(occlusionBuffer.getDepth(0, BUFFER_HEIGHT - 1), 0.0f, 0.0001f);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(occlusionBuffer.getDepth(BUFFER_WIDTH / 2 - 1, 0), 0.0f, 0.0001f);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(occlusionBuffer.getDepth(1, 0), 0.0f, 0.0001f);
+
+        // Straddles the diagonal, neither triangle covers it fully
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(occlusionBuffer.getDepth(0, 0), 1.0f, 0.0001f);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(occlusionBuffer.getDepth(BUFFER_WIDTH / 2, 0), 1.0f, 0.0001f);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(occlusionBuffer.getDepth(BUFFER_WIDTH - 1, BUFFER_HEIGHT - 1), 1.0f, 0.0001f);
+
+        // Next frame starts empty
+        occlusionBuffer.clear(Math::Mat4());
+        occlusionBuffer.rasterize();
+        CPPUNIT_ASSERT_EQUAL(occlusionBuffer.getRasterizedTriangles(), 0);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(occlusionBuffer.getDepth(0, 0), 1.0f, 0.0001f);
+    }
+
+    void testVisibility() {
+        Graphene::OcclusionBuffer occlusionBuffer(BUFFER_WIDTH, BUFFER_HEIGHT, 0);
+        occlusionBuffer.clear(Math::Mat4());
+        occlusionBuffer.addOccluder(this->positions, this->frontFaces, Math::Mat4());
+        occlusionBuffer.rasterize();
+
+        // Clear of the diagonal, the pixels along it are covered by neither triangle
+        Graphene::BoundingBox behind(Math::Vec3(-0.9f, 0.2f, 0.5f), Math::Vec3(-0.6f, 0.8f, 0.8f));
+        CPPUNIT_ASSERT(!occlusionBuffer.isVisible(behind));
+
+        Graphene::BoundingBox inFront(Math::Vec3(-0.8f, -0.5f, -0.5f), Math::Vec3(-0.2f, 0.5f, -0.2f));
+        CPPUNIT_ASSERT(occlusionBuffer.isVisible(inFront));
+
+        Graphene::BoundingBox aside(Math::Vec3(0.2f, -0.5f, 0.5f), Math::Vec3(0.8f, 0.5f, 0.8f));
+        CPPUNIT_ASSERT(occlusionBuffer.isVisible(aside));
+
+        // Partially covered is visible
+        Graphene::BoundingBox across(Math::Vec3(-0.5f, -0.5f, 0.5f), Math::Vec3(0.5f, 0.5f, 0.8f));
+        CPPUNIT_ASSERT(occlusionBuffer.isVisible(across));
+
+        // Reaching past the near plane, nothing to compare against
+        Graphene::BoundingBox crossing(Math::Vec3(-0.8f, -0.5f, -2.0f), Math::Vec3(-0.2f, 0.5f, 0.8f));
+        CPPUNIT_ASSERT(occlusionBuffer.isVisible(crossing));
+
+        CPPUNIT_ASSERT(occlusionBuffer.isVisible(Graphene::BoundingBox()));
+    }
+
+    void testCulledTriangles() {
+        Graphene::OcclusionBuffer occlusionBuffer(BUFFER_WIDTH, BUFFER_HEIGHT, 0);
+        occlusionBuffer.clear(Math::Mat4());
+        occlusionBuffer.addOccluder(this->positions, this->backFaces, Math::Mat4());
+
+        // Crosses the near plane
+        std::vector<float> nearPositions = { -1.0f, -1.0f, -2.0f, -1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f };
+        std::vector<int> nearFaces = { 0, 1, 2 };
+        occlusionBuffer.addOccluder(nearPositions, nearFaces, Math::Mat4());
+        occlusionBuffer.rasterize();
+
+        CPPUNIT_ASSERT_EQUAL(occlusionBuffer.getRasterizedTriangles(), 0);
+
+        Graphene::BoundingBox behind(Math::Vec3(-0.8f, -0.5f, 0.5f), Math::Vec3(-0.2f, 0.5f, 0.8f));
+        CPPUNIT_ASSERT(occlusionBuffer.isVisible(behind));
+    }
+
+    void testWorkers() {
+        // Sloped triangles, depth varies across the bands
+        std::vector<float> slopedPositions = {
+            -1.0f, -1.0f, -0.5f,
+             1.0f, -1.0f,  0.9f,
+             1.0f,  1.0f,  0.1f,
+            -1.0f,  1.0f,  0.3f
+        };
+
+        Graphene::OcclusionBuffer serialBuffer(BUFFER_WIDTH, BUFFER_HEIGHT, 0);
+        Graphene::OcclusionBuffer parallelBuffer(BUFFER_WIDTH, BUFFER_HEIGHT, 3);
+        CPPUNIT_ASSERT_EQUAL(parallelBuffer.getWorkers(), 3);
+
+        for (int frame = 0; frame < 3; frame++) {
+            for (auto occlusionBuffer: { &serialBuffer, &parallelBuffer }) {
+                occlusionBuffer->clear(Math::Mat4());
+                occlusionBuffer->addOccluder(slopedPositions, this->frontFaces, Math::Mat4());
+                occlusionBuffer->rasterize();
+            }
+
+            for (int y = 0; y < BUFFER_HEIGHT; y++) {
+                for (int x = 0; x < BUFFER_WIDTH; x++) {
+                    CPPUNIT_ASSERT_EQUAL(serialBuffer.getDepth(x, y), parallelBuffer.getDepth(x, y));
+                }
+            }
+        }
+
+        CPPUNIT_ASSERT(serialBuffer.getDepth(0, BUFFER_HEIGHT - 1) < serialBuffer.getDepth(BUFFER_WIDTH - 1, 0));
+    }
+
+    void testConservative() {
+        // Right edge halfway through pixel column 32, sloped along x
+        float edge = 1.0f / BUFFER_WIDTH;
+        std::vector<float> slopedPositions = {
+            -1.0f, -1.0f, 0.0f,
+             edge, -1.0f, 0.5f,
+             edge,  1.0f, 0.5f,
+            -1.0f,  1.0f, 0.0f
+        };
+
+        Graphene::OcclusionBuffer occlusionBuffer(BUFFER_WIDTH, BUFFER_HEIGHT, 0);
+        occlusionBuffer.clear(Math::Mat4());
+        occlusionBuffer.addOccluder(slopedPositions, this->frontFaces, Math::Mat4());
+        occlusionBuffer.rasterize();
+
+        // Half covered column is left empty
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(occlusionBuffer.getDepth(BUFFER_WIDTH / 2 - 1, 0), 0.5f * 32.0f / 32.5f, 0.0001f);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(occlusionBuffer.getDepth(BUFFER_WIDTH / 2, 0), 1.0f, 0.0001f);
+
+        // Peeking past the edge within the half covered column
+        float peekLeft = 0.2f / BUFFER_WIDTH;
+        float peekRight = 0.8f / BUFFER_WIDTH;
+        Graphene::BoundingBox peeking(Math::Vec3(peekLeft, -0.5f, 0.9f), Math::Vec3(peekRight, 0.5f, 0.95f));
+        CPPUNIT_ASSERT(occlusionBuffer.isVisible(peeking));
+
+        // Farthest depth over the pixel, a box behind its center but not its far side is visible
+        float pixelLeft = -2.0f / BUFFER_WIDTH;
+        float centerDepth = 0.5f * 31.5f / 32.5f;
+        float farDepth = 0.5f * 32.0f / 32.5f;
+        Graphene::BoundingBox between(Math::Vec3(pixelLeft, -0.5f, (centerDepth + farDepth) * 0.5f),
+                                      Math::Vec3(pixelLeft * 0.5f, 0.5f, 0.95f));
+        CPPUNIT_ASSERT(occlusionBuffer.isVisible(between));
+
+        Graphene::BoundingBox behind(Math::Vec3(pixelLeft, -0.5f, farDepth + 0.01f), Math::Vec3(pixelLeft * 0.5f, 0.5f, 0.95f));
+        CPPUNIT_ASSERT(!occlusionBuffer.isVisible(behind));
+    }
+
+private:
+    std::vector<float> positions;
+    std::vector<int> frontFaces;
+    std::vector<int> backFaces;
+};
+
+int main() {
+    CppUnit::TestSuite* suite = new CppUnit::TestSuite("TestOcclusionBuffer");
+    suite->addTest(new CppUnit::TestCaller<TestOcclusionBuffer>("testRasterize", &TestOcclusionBuffer::testRasterize));
+    suite->addTest(new CppUnit::TestCaller<TestOcclusionBuffer>("testVisibility", &TestOcclusionBuffer::testVisibility));
+    suite->addTest(new CppUnit::TestCaller<TestOcclusionBuffer>("testCulledTriangles", &TestOcclusionBuffer::testCulledTriangles));
+    suite->addTest(new CppUnit::TestCaller<TestOcclusionBuffer>("testWorkers", &TestOcclusionBuffer::testWorkers));
+    suite->addTest(new CppUnit::TestCaller<TestOcclusionBuffer>("testConservative", &TestOcclusionBuffer::testConservative));
+
+    CppUnit::TextTestRunner runner;
+    runner.addTest(suite);
+
+    return runner.run() ? 0 : 1;
+}
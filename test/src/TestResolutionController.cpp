@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <TestGraphene.h>
+#include <ResolutionController.h>
+#include <stdexcept>
+
+#define TARGET_FRAME_TIME (1000.0f / 60.0f)  // GPU budget is 15ms
+
+class TestResolutionController: public CppUnit::TestFixture {
+public:
+    void testDrop() {
+        Graphene::ResolutionController resolutionController(TARGET_FRAME_TIME, 0.5f, 1.0f);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(resolutionController.getScale(), 1.0f, 0.0001f);
+
+        // Twice the budget halves the pixel count
+        resolutionController.update(30.0f);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(resolutionController.getScale(), 0.7f, 0.0001f);
+
+        // Timings still measured at the old scale are ignored
+        this->update(resolutionController, 30.0f, RESOLUTION_SETTLE_FRAMES);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(resolutionController.getScale(), 0.7f, 0.0001f);
+
+        // Even a slight overrun drops a step, the minimum holds
+        resolutionController.update(15.1f);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(resolutionController.getScale(), 0.65f, 0.0001f);
+
+        this->update(resolutionController, 60.0f, RESOLUTION_SETTLE_FRAMES + 1);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(resolutionController.getScale(), 0.5f, 0.0001f);
+    }
+
+    void testRaise() {
+        Graphene::ResolutionController resolutionController(TARGET_FRAME_TIME, 0.5f, 1.0f);
+        this->update(resolutionController, 60.0f, RESOLUTION_SETTLE_FRAMES + 1);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(resolutionController.getScale(), 0.5f, 0.0001f);
+
+        this->update(resolutionController, 5.0f, RESOLUTION_RAISE_FRAMES - 1);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(resolutionController.getScale(), 0.5f, 0.0001f);
+
+        // Raised a step at a time, up to the maximum
+        resolutionController.update(5.0f);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(resolutionController.getScale(), 0.55f, 0.0001f);
+
+        this->update(resolutionController, 1.0f, (RESOLUTION_SETTLE_FRAMES + RESOLUTION_RAISE_FRAMES) * 20);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(resolutionController.getScale(), 1.0f, 0.0001f);
+    }
+
+    void testHysteresis() {
+        Graphene::ResolutionController resolutionController(TARGET_FRAME_TIME, 0.5f, 1.0f);
+        resolutionController.update(30.0f);
+        this->update(resolutionController, 11.0f, RESOLUTION_SETTLE_FRAMES);
+
+        // Under the budget, but a raise would get too close to it
+        this->update(resolutionController, 11.0f, RESOLUTION_RAISE_FRAMES * 10);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(resolutionController.getScale(), 0.7f, 0.0001f);
+
+        // Interrupted streaks do not add up
+        for (int i = 0; i < RESOLUTION_RAISE_FRAMES * 10; i++) {
+            resolutionController.update((i % RESOLUTION_RAISE_FRAMES == 0) ? 11.0f : 5.0f);
+        }
+
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(resolutionController.getScale(), 0.7f, 0.0001f);
+    }
+
+    void testBounds() {
+        CPPUNIT_ASSERT_THROW(Graphene::ResolutionController(0.0f, 0.5f, 1.0f), std::invalid_argument);
+        CPPUNIT_ASSERT_THROW(Graphene::ResolutionController(TARGET_FRAME_TIME, 0.0f, 1.0f), std::invalid_argument);
+        CPPUNIT_ASSERT_THROW(Graphene::ResolutionController(TARGET_FRAME_TIME, 0.8f, 0.6f), std::invalid_argument);
+        CPPUNIT_ASSERT_THROW(Graphene::ResolutionController(TARGET_FRAME_TIME, 0.5f, 1.5f), std::invalid_argument);
+
+        Graphene::ResolutionController resolutionController(TARGET_FRAME_TIME, 0.6f, 0.8f);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(resolutionController.getScale(), 0.8f, 0.0001f);
+
+        resolutionController.update(1000.0f);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(resolutionController.getScale(), 0.6f, 0.0001f);
+    }
+
+private:
+    void update(Graphene::ResolutionController& resolutionController, float gpuFrameTime, int frames) {
+        for (int i = 0; i < frames; i++) {
+            resolutionController.update(gpuFrameTime);
+        }
+    }
+};
+
+int main() {
+    CppUnit::TestSuite* suite = new CppUnit::TestSuite("TestResolutionController");
+    suite->addTest(new CppUnit::TestCaller<TestResolutionController>("testDrop", &TestResolutionController::testDrop));
+    suite->addTest(new CppUnit::TestCaller<TestResolutionController>("testRaise", &TestResolutionController::testRaise));
+    suite->addTest(new CppUnit::TestCaller<TestResolutionController>("testHysteresis", &TestResolutionController::testHysteresis));
+    suite->addTest(new CppUnit::TestCaller<TestResolutionController>("testBounds", &TestResolutionController::testBounds));
+
+    CppUnit::TextTestRunner runner;
+    runner.addTest(suite);
+
+    return runner.run() ? 0 : 1;
+}
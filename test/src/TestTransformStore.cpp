@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2013 Pavlo Lavrenenko
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <TestGraphene.h>
+#include <TransformStore.h>
+#include <Mat4.h>
+#include <Vec3.h>
+#include <stdexcept>
+
+class TestTransformStore: public CppUnit::TestFixture {
+public:
+    void testHierarchy() {
+        auto& transformStore = Graphene::TransformStore::getInstance();
+
+        int child = transformStore.createNode();
+        int parent = transformStore.createNode();  // Parent follows the child, forces nodes sort
+        transformStore.setLocalTransformation(child, this->translation(0.0f, 1.0f, 0.0f), Math::Mat4());
+        transformStore.setLocalTransformation(parent, this->translation(1.0f, 0.0f, 0.0f), Math::Mat4());
+        ASSERT_VEC3_EQUAL(transformStore.getWorldPosition(child), Math::Vec3(0.0f, 1.0f, 0.0f));
+
+        transformStore.setParent(child, parent);
+        ASSERT_VEC3_EQUAL(transformStore.getWorldPosition(child), Math::Vec3(1.0f, 1.0f, 0.0f));
+
+        transformStore.setLocalTransformation(parent, this->translation(2.0f, 0.0f, 0.0f), Math::Mat4());
+        ASSERT_VEC3_EQUAL(transformStore.getWorldPosition(child), Math::Vec3(2.0f, 1.0f, 0.0f));
+
+        transformStore.destroyNode(parent);
+        ASSERT_VEC3_EQUAL(transformStore.getWorldPosition(child), Math::Vec3(0.0f, 1.0f, 0.0f));
+
+        transformStore.destroyNode(child);
+    }
+
+    void testInterleaved() {
+        auto& transformStore = Graphene::TransformStore::getInstance();
+
+        int root = transformStore.createNode();
+        int child = transformStore.createNode();
+        int grandchild = transformStore.createNode();
+        int sibling = transformStore.createNode();
+        transformStore.setParent(child, root);
+        transformStore.setParent(grandchild, child);
+        transformStore.setParent(sibling, root);
+        transformStore.update();
+
+        // Reads between the passes resolve their own chain, other changes stay pending
+        for (int step = 1; step <= 3; step++) {
+            float offset = static_cast<float>(step);
+
+            transformStore.setLocalTransformation(root, this->translation(offset, 0.0f, 0.0f), Math::Mat4());
+            ASSERT_VEC3_EQUAL(transformStore.getWorldPosition(sibling), Math::Vec3(offset, 0.0f, 0.0f));
+
+            transformStore.setLocalTransformation(child, this->translation(0.0f, offset, 0.0f), Math::Mat4());
+            ASSERT_VEC3_EQUAL(transformStore.getWorldPosition(grandchild), Math::Vec3(offset, offset, offset - 1.0f));
+
+            transformStore.setLocalTransformation(grandchild, this->translation(0.0f, 0.0f, offset), Math::Mat4());
+            ASSERT_VEC3_EQUAL(transformStore.getWorldPosition(grandchild), Math::Vec3(offset, offset, offset));
+            ASSERT_VEC3_EQUAL(transformStore.getWorldPosition(child), Math::Vec3(offset, offset, 0.0f));
+        }
+
+        transformStore.update();
+        ASSERT_VEC3_EQUAL(transformStore.getWorldPosition(grandchild), Math::Vec3(3.0f, 3.0f, 3.0f));
+        ASSERT_VEC3_EQUAL(transformStore.getWorldPosition(sibling), Math::Vec3(3.0f, 0.0f, 0.0f));
+
+        transformStore.destroyNode(sibling);
+        transformStore.destroyNode(grandchild);
+        transformStore.destroyNode(child);
+        transformStore.destroyNode(root);
+    }
+
+    void testHandles() {
+        auto& transformStore = Graphene::TransformStore::getInstance();
+        int nodesCount = transformStore.getNodesCount();
+
+        int node = transformStore.createNode();
+        CPPUNIT_ASSERT_EQUAL(transformStore.getNodesCount(), nodesCount + 1);
+
+        transformStore.destroyNode(node);
+        CPPUNIT_ASSERT_EQUAL(transformStore.getNodesCount(), nodesCount);
+        CPPUNIT_ASSERT_THROW(transformStore.getWorldPosition(node), std::invalid_argument);
+    }
+
+private:
+    Math::Mat4 translation(float x, float y, float z) {
+        Math::Mat4 translation;
+        translation.set(0, 3, x);
+        translation.set(1, 3, y);
+        translation.set(2, 3, z);
+        return translation;
+    }
+};
+
+int main() {
+    CppUnit::TestSuite* suite = new CppUnit::TestSuite("TestTransformStore");
+    suite->addTest(new CppUnit::TestCaller<TestTransformStore>("testHierarchy", &TestTransformStore::testHierarchy));
+    suite->addTest(new CppUnit::TestCaller<TestTransformStore>("testInterleaved", &TestTransformStore::testInterleaved));
+    suite->addTest(new CppUnit::TestCaller<TestTransformStore>("testHandles", &TestTransformStore::testHandles));
+
+    CppUnit::TextTestRunner runner;
+    runner.addTest(suite);
+
+    return runner.run() ? 0 : 1;
+}
@@ -23,11 +23,18 @@
 #ifndef OPENGL_H
 #define OPENGL_H
 
+#include <cstddef>
+
+#define GLint       int
 #define GLsizei     int
 #define GLuint      unsigned int
 #define GLenum      unsigned int
+#define GLboolean   unsigned char
+#define GLintptr    ptrdiff_t
+#define GLsizeiptr  ptrdiff_t
 
 #define GL_UNIFORM_BUFFER               0
+#define GL_STREAM_DRAW                  0
 #define GL_DYNAMIC_DRAW                 0
 #define GL_TRIANGLES                    0
 #define GL_TEXTURE_2D                   0
@@ -36,15 +43,36 @@
 #define GL_UNSIGNED_INT                 0
 #define GL_UNSIGNED_BYTE                0
 #define GL_RGBA                         0
-#define GL_RGBA16F                      0
 #define GL_LINEAR                       0
 #define GL_LINEAR_MIPMAP_LINEAR         0
 #define GL_TEXTURE_MIN_FILTER           0
 #define GL_TEXTURE_MAG_FILTER           0
 #define GL_TEXTURE0                     0
 #define GL_SRGB8_ALPHA8                 0
-#define GL_DEPTH_COMPONENT16            0
 #define GL_NONE                         0
+#define GL_TEXTURE_BUFFER               0
+#define GL_COLOR_ATTACHMENT0            0
+#define GL_DEPTH_ATTACHMENT             0
+#define GL_COLOR_BUFFER_BIT             0
+
+// Distinct values, tracked by GLStateCache
+#define GL_FALSE                        0
+#define GL_TRUE                         1
+#define GL_BLEND                        0x0BE2
+#define GL_DEPTH_TEST                   0x0B71
+#define GL_ELEMENT_ARRAY_BUFFER         0x8893
+#define GL_ARRAY_BUFFER                 0x8892
+#define GL_READ_FRAMEBUFFER             0x8CA8
+#define GL_DRAW_FRAMEBUFFER             0x8CA9
+#define GL_FRAMEBUFFER                  0x8D40
+
+// Distinct values, told apart by FrameGraph and RenderTargetPool
+#define GL_RGBA8                        0x8058
+#define GL_RGBA16                       0x805B
+#define GL_RGBA16F                      0x881A
+#define GL_DEPTH_COMPONENT16            0x81A5
+#define GL_DEPTH_COMPONENT24            0x81A6
+#define GL_DEPTH_COMPONENT32F           0x8CAC
 
 #define glGenBuffers(...)           mock(__VA_ARGS__)
 #define glDeleteBuffers(...)        mock(__VA_ARGS__)
@@ -55,6 +83,7 @@
 #define glBindVertexArray(...)      mock(__VA_ARGS__)
 #define glBindBuffer(...)           mock(__VA_ARGS__)
 #define glBindBufferBase(...)       mock(__VA_ARGS__)
+#define glBindBufferRange(...)      mock(__VA_ARGS__)
 #define glBufferData(...)           mock(__VA_ARGS__)
 #define glBufferSubData(...)        mock(__VA_ARGS__)
 #define glDrawElements(...)         mock(__VA_ARGS__)
@@ -62,6 +91,22 @@
 #define glTexParameteri(...)        mock(__VA_ARGS__)
 #define glGenerateMipmap(...)       mock(__VA_ARGS__)
 #define glTexStorage2D(...)         mock(__VA_ARGS__)
+#define glEnable(...)               mock(__VA_ARGS__)
+#define glDisable(...)              mock(__VA_ARGS__)
+#define glBlendFunc(...)            mock(__VA_ARGS__)
+#define glDepthFunc(...)            mock(__VA_ARGS__)
+#define glDepthMask(...)            mock(__VA_ARGS__)
+#define glColorMask(...)            mock(__VA_ARGS__)
+#define glCullFace(...)             mock(__VA_ARGS__)
+#define glScissor(...)              mock(__VA_ARGS__)
+#define glBindFramebuffer(...)      mock(__VA_ARGS__)
+#define glDeleteFramebuffers(...)   mock(__VA_ARGS__)
+#define glUseProgram(...)           mock(__VA_ARGS__)
+#define glGenFramebuffers(...)      mock(__VA_ARGS__)
+#define glFramebufferTexture(...)   mock(__VA_ARGS__)
+#define glDrawBuffers(...)          mock(__VA_ARGS__)
+#define glTexBuffer(...)            mock(__VA_ARGS__)
+#define glBlitFramebuffer(...)      mock(__VA_ARGS__)
 
 template<typename T>
 void mock(T arg) { (void)arg; }